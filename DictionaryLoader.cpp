@@ -0,0 +1,502 @@
+#include "DictionaryLoader.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#if defined(_WIN32)
+#include <sstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef WORDLE_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+// ============================================================================
+// Sources
+// ============================================================================
+
+static DictionarySources &defaultSources() {
+    static DictionarySources sources;
+    return sources;
+}
+
+void setDefaultDictionarySources(const DictionarySources& sources) {
+    defaultSources() = sources;
+}
+
+const DictionarySources& defaultDictionarySources() {
+    return defaultSources();
+}
+
+DictionarySources dictionarySourcesFromArgs(int argc, char *argv[]) {
+    DictionarySources sources;
+    if (const char *env = std::getenv("WORDLE_ANSWERS")) sources.answersPath = env;
+    if (const char *env = std::getenv("WORDLE_ACCEPTED")) sources.acceptedPath = env;
+    if (const char *env = std::getenv("WORDLE_DICTIONARY")) sources.binaryPath = env;
+    bool overridden = std::getenv("WORDLE_ANSWERS") || std::getenv("WORDLE_ACCEPTED") || std::getenv("WORDLE_DICTIONARY");
+    for (int i = 1; i + 1 < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--answers") sources.answersPath = argv[++i];
+        else if (arg == "--accepted") sources.acceptedPath = argv[++i];
+        else if (arg == "--dictionary") sources.binaryPath = argv[++i];
+        else continue;
+        overridden = true;
+    }
+    sources.embedded = !overridden;
+    return sources;
+}
+
+void DictionaryLoadReport::add(const DictionaryLoadReport& other) {
+    bytes += other.bytes;
+    lines += other.lines;
+    accepted += other.accepted;
+    rejectedLength += other.rejectedLength;
+    rejectedAlphabet += other.rejectedAlphabet;
+    duplicates += other.duplicates;
+    seconds += other.seconds;
+    for (const std::string& sample : other.rejectedSamples) {
+        if (rejectedSamples.size() < 10) rejectedSamples.push_back(sample);
+    }
+    if (error.empty()) error = other.error;
+}
+
+// ============================================================================
+// File access
+// ============================================================================
+
+// Read-only view of a whole file: memory-mapped where possible, decompressed
+// into an owned buffer for gzip input
+class FileView {
+public:
+    FileView() = default;
+    FileView(const FileView&) = delete;
+    FileView& operator=(const FileView&) = delete;
+    ~FileView() {
+#if !defined(_WIN32)
+        if (mapped) munmap(mapped, mappedSize);
+#endif
+    }
+
+    bool open(const std::string& path, std::string& error);
+    const char *data() const { return mapped ? static_cast<const char *>(mapped) : buffer.data(); }
+    size_t size() const { return mapped ? mappedSize : buffer.size(); }
+
+private:
+    bool readGzip(const std::string& path, std::string& error);
+
+    void *mapped = nullptr;
+    size_t mappedSize = 0;
+    std::string buffer;
+};
+
+static bool hasGzipMagic(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    unsigned char magic[2] = {};
+    in.read(reinterpret_cast<char *>(magic), 2);
+    return in.gcount() == 2 && magic[0] == 0x1f && magic[1] == 0x8b;
+}
+
+bool FileView::readGzip(const std::string& path, std::string& error) {
+#ifdef WORDLE_HAVE_ZLIB
+    gzFile file = gzopen(path.c_str(), "rb");
+    if (!file) {
+        error = "Could not open " + path;
+        return false;
+    }
+    char chunk[1 << 16];
+    int read;
+    while ((read = gzread(file, chunk, sizeof(chunk))) > 0) buffer.append(chunk, read);
+    bool ok = read == 0;
+    gzclose(file);
+    if (!ok) error = "Corrupt gzip stream in " + path;
+    return ok;
+#else
+    error = path + " is gzip-compressed but zlib support was not built in";
+    return false;
+#endif
+}
+
+bool FileView::open(const std::string& path, std::string& error) {
+    if (hasGzipMagic(path)) return readGzip(path, error);
+#if defined(_WIN32)
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        error = "Could not open " + path;
+        return false;
+    }
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    buffer = contents.str();
+    return true;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "Could not open " + path;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        error = "Could not stat " + path;
+        return false;
+    }
+    mappedSize = static_cast<size_t>(info.st_size);
+    if (mappedSize > 0) {
+        void *address = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            error = "Could not map " + path;
+            mappedSize = 0;
+            return false;
+        }
+        mapped = address;
+    }
+    ::close(fd);
+    return true;
+#endif
+}
+
+// ============================================================================
+// Ingestion
+// ============================================================================
+
+static const int KEY_BITS_PER_LETTER = 6;
+
+uint32_t packWordKey(const PackedWord& word) {
+    uint32_t key = 0;
+    for (int i = 0; i < WORD_LENGTH; ++i) key = (key << KEY_BITS_PER_LETTER) | word[i];
+    return key;
+}
+
+PackedWord unpackWordKey(uint32_t key) {
+    PackedWord word;
+    for (int i = WORD_LENGTH - 1; i >= 0; --i) {
+        word[i] = static_cast<uint8_t>(key & (MAX_ALPHABET_SIZE - 1));
+        key >>= KEY_BITS_PER_LETTER;
+    }
+    return word;
+}
+
+static std::string wordFromKey(const SolverAlphabet& alphabet, uint32_t key) {
+    std::string word;
+    for (uint8_t letter : unpackWordKey(key)) appendUtf8(word, alphabet.symbol(letter));
+    return word;
+}
+
+static bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+}
+
+// LSD radix sort over the 30-bit keys in two 15-bit passes
+static void radixSortKeys(std::vector<uint32_t>& keys) {
+    const int DIGIT_BITS = 15;
+    const uint32_t mask = (1u << DIGIT_BITS) - 1;
+    std::vector<uint32_t> scratch(keys.size());
+    std::vector<size_t> counts;
+    for (int shift = 0; shift < WORD_LENGTH * KEY_BITS_PER_LETTER; shift += DIGIT_BITS) {
+        counts.assign(size_t(1) << DIGIT_BITS, 0);
+        for (uint32_t key : keys) counts[(key >> shift) & mask]++;
+        size_t total = 0;
+        for (size_t &count : counts) {
+            size_t start = total;
+            total += count;
+            count = start;
+        }
+        for (uint32_t key : keys) scratch[counts[(key >> shift) & mask]++] = key;
+        keys.swap(scratch);
+    }
+}
+
+bool ingestWordSource(const std::string& path, SolverAlphabet& alphabet, std::vector<uint32_t>& keys, DictionaryLoadReport& report) {
+    auto started = std::chrono::steady_clock::now();
+    FileView file;
+    if (!file.open(path, report.error)) return false;
+    report.bytes += file.size();
+
+    keys.clear();
+    keys.reserve(file.size() / (WORD_LENGTH + 1) + 1);
+    std::u32string symbols;
+    const char *cursor = file.data();
+    const char *end = cursor + file.size();
+    while (cursor < end) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(cursor, '\n', end - cursor));
+        if (!lineEnd) lineEnd = end;
+        const char *first = cursor;
+        const char *last = lineEnd;
+        cursor = lineEnd + 1;
+        while (first < last && isBlank(*first)) ++first;
+        while (last > first && isBlank(last[-1])) --last;
+        if (first == last) continue;
+        report.lines++;
+
+        auto reject = [&](size_t &counter) {
+            counter++;
+            if (report.rejectedSamples.size() < 10) report.rejectedSamples.emplace_back(first, last);
+        };
+        // ASCII lines skip the UTF-8 decoder
+        bool ascii = true;
+        for (const char *c = first; c < last && ascii; ++c) ascii = static_cast<unsigned char>(*c) < 0x80;
+        if (ascii) {
+            symbols.assign(first, last);
+        } else if (!decodeUtf8(first, last, symbols)) {
+            reject(report.rejectedAlphabet);
+            continue;
+        }
+        if (symbols.size() != WORD_LENGTH) {
+            reject(report.rejectedLength);
+            continue;
+        }
+        PackedWord packed;
+        bool valid = true;
+        for (int i = 0; i < WORD_LENGTH && valid; ++i) {
+            char32_t c = foldToUpper(symbols[i]);
+            int index = isWordLetter(c) ? alphabet.add(c) : -1;
+            valid = index >= 0;
+            if (valid) packed[i] = static_cast<uint8_t>(index);
+        }
+        if (!valid) {
+            reject(report.rejectedAlphabet);
+            continue;
+        }
+        keys.push_back(packWordKey(packed));
+    }
+    report.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return true;
+}
+
+void canonicalizeKeys(std::vector<uint32_t>& keys, const std::vector<uint8_t>& remap, DictionaryLoadReport& report) {
+    auto started = std::chrono::steady_clock::now();
+    for (uint32_t &key : keys) {
+        PackedWord word = unpackWordKey(key);
+        for (uint8_t &letter : word) letter = remap[letter];
+        key = packWordKey(word);
+    }
+    size_t valid = keys.size();
+    radixSortKeys(keys);
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    report.duplicates += valid - keys.size();
+    report.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+}
+
+SolverDictionary dictionaryFromKeys(const SolverAlphabet& alphabet, const std::vector<uint32_t>& answers, const std::vector<uint32_t>& accepted) {
+    SolverDictionary dict;
+    dict.alphabet = alphabet;
+    auto addKey = [&dict](uint32_t key) {
+        std::string word = wordFromKey(dict.alphabet, key);
+        dict.indexByWord.emplace(word, dict.size());
+        dict.words.push_back(word);
+        dict.packed.push_back(unpackWordKey(key));
+    };
+    dict.words.reserve(answers.size() + accepted.size());
+    dict.packed.reserve(answers.size() + accepted.size());
+    for (uint32_t key : answers) addKey(key);
+    dict.answerCount = dict.size();
+    // Both lists are sorted, so skipping answers is a merge walk
+    size_t a = 0;
+    for (uint32_t key : accepted) {
+        while (a < answers.size() && answers[a] < key) ++a;
+        if (a < answers.size() && answers[a] == key) continue;
+        addKey(key);
+    }
+    return dict;
+}
+
+// Answers and accepted words from keys laid out as in the binary dictionary
+static SolverDictionary dictionaryFromLayout(const SolverAlphabet& alphabet, const uint32_t *keys, size_t answerCount, size_t total) {
+    return dictionaryFromKeys(alphabet, std::vector<uint32_t>(keys, keys + answerCount), std::vector<uint32_t>(keys + answerCount, keys + total));
+}
+
+// ============================================================================
+// Binary dictionary
+// ============================================================================
+
+// Layout (host byte order, little-endian on every supported platform): magic,
+// version, word length, answer count, total count, alphabet size, one uint32
+// code point per alphabet symbol, then one uint32 key per word (answers first)
+static const char BINARY_MAGIC[4] = {'W', 'D', 'I', 'C'};
+static const uint32_t BINARY_VERSION = 2;
+static const int BINARY_HEADER_WORDS = 5;
+
+bool writeBinaryDictionary(const std::string& path, const SolverDictionary& dict, std::string& error) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        error = "Could not write " + path;
+        return false;
+    }
+    std::vector<uint32_t> header = {BINARY_VERSION, WORD_LENGTH, static_cast<uint32_t>(dict.answerCount), static_cast<uint32_t>(dict.size()), static_cast<uint32_t>(dict.alphabet.size())};
+    for (int i = 0; i < dict.alphabet.size(); ++i) header.push_back(static_cast<uint32_t>(dict.alphabet.symbol(i)));
+    std::vector<uint32_t> keys(dict.size());
+    for (int i = 0; i < dict.size(); ++i) keys[i] = packWordKey(dict.packed[i]);
+    out.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    out.write(reinterpret_cast<const char *>(header.data()), header.size() * sizeof(uint32_t));
+    out.write(reinterpret_cast<const char *>(keys.data()), keys.size() * sizeof(uint32_t));
+    if (!out) {
+        error = "Short write to " + path;
+        return false;
+    }
+    return true;
+}
+
+// What ingestion guarantees, checked again for a file that may be corrupt or written by
+// hand: sorted distinct word letters, every key in range, each list strictly increasing
+// and no accepted-only word that is also an answer
+static bool isCanonicalLayout(const std::vector<uint32_t>& symbols, const std::vector<uint32_t>& keys, size_t answerCount, std::string& problem) {
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        if (!isWordLetter(static_cast<char32_t>(symbols[i]))) {
+            problem = "has an alphabet symbol that is not a letter";
+            return false;
+        }
+        if (i > 0 && symbols[i] <= symbols[i - 1]) {
+            problem = "has a repeated or unsorted alphabet";
+            return false;
+        }
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+        bool inRange = (keys[i] >> (WORD_LENGTH * KEY_BITS_PER_LETTER)) == 0;
+        for (uint8_t letter : unpackWordKey(keys[i])) inRange = inRange && letter < symbols.size();
+        if (!inRange) {
+            problem = "references letters outside its alphabet";
+            return false;
+        }
+        if (i > 0 && i != answerCount && keys[i] <= keys[i - 1]) {
+            problem = "has repeated or unsorted words";
+            return false;
+        }
+    }
+    // Both lists are sorted, so finding shared words is a merge walk
+    size_t a = 0;
+    for (size_t i = answerCount; i < keys.size(); ++i) {
+        while (a < answerCount && keys[a] < keys[i]) ++a;
+        if (a < answerCount && keys[a] == keys[i]) {
+            problem = "lists a word both as an answer and as an accepted-only word";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool readBinaryDictionary(const std::string& path, SolverDictionary& dict, std::string& error) {
+    FileView file;
+    if (!file.open(path, error)) return false;
+    size_t headerSize = sizeof(BINARY_MAGIC) + BINARY_HEADER_WORDS * sizeof(uint32_t);
+    if (file.size() < headerSize || std::memcmp(file.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+        error = path + " is not a binary dictionary";
+        return false;
+    }
+    uint32_t header[BINARY_HEADER_WORDS];
+    std::memcpy(header, file.data() + sizeof(BINARY_MAGIC), sizeof(header));
+    uint32_t answerCount = header[2], total = header[3], alphabetSize = header[4];
+    if (header[0] != BINARY_VERSION || header[1] != WORD_LENGTH || answerCount > total || alphabetSize > MAX_ALPHABET_SIZE
+        || file.size() != headerSize + (size_t(alphabetSize) + total) * sizeof(uint32_t)) {
+        error = path + " has an unsupported or truncated layout";
+        return false;
+    }
+    std::vector<uint32_t> symbols(alphabetSize);
+    std::memcpy(symbols.data(), file.data() + headerSize, symbols.size() * sizeof(uint32_t));
+    std::vector<uint32_t> keys(total);
+    std::memcpy(keys.data(), file.data() + headerSize + symbols.size() * sizeof(uint32_t), keys.size() * sizeof(uint32_t));
+    std::string problem;
+    if (!isCanonicalLayout(symbols, keys, answerCount, problem)) {
+        error = path + " " + problem;
+        return false;
+    }
+    SolverAlphabet alphabet;
+    for (uint32_t symbol : symbols) alphabet.add(static_cast<char32_t>(symbol));
+    dict = dictionaryFromLayout(alphabet, keys.data(), answerCount, total);
+    return true;
+}
+
+// ============================================================================
+// Compiled-in dictionary
+// ============================================================================
+
+static SolverDictionary dictionaryFromEmbedded(const EmbeddedDictionary& embedded) {
+    SolverAlphabet alphabet;
+    for (int i = 0; i < embedded.alphabetSize; ++i) alphabet.add(static_cast<char32_t>(embedded.alphabet[i]));
+    return dictionaryFromLayout(alphabet, embedded.keys, embedded.answerCount, embedded.wordCount);
+}
+
+static bool isEmbeddedDictionary(const SolverDictionary& dict, const EmbeddedDictionary& embedded) {
+    if (dict.size() != embedded.wordCount || dict.answerCount != embedded.answerCount || dict.alphabet.size() != embedded.alphabetSize) return false;
+    for (int i = 0; i < embedded.alphabetSize; ++i) {
+        if (dict.alphabet.symbol(i) != static_cast<char32_t>(embedded.alphabet[i])) return false;
+    }
+    for (int i = 0; i < embedded.wordCount; ++i) {
+        if (packWordKey(dict.packed[i]) != embedded.keys[i]) return false;
+    }
+    return true;
+}
+
+bool seedOpenerRankings(const SolverDictionary& dict, SolverCache& cache) {
+    const EmbeddedDictionary *embedded = embeddedDictionary();
+    if (!embedded || !isEmbeddedDictionary(dict, *embedded)) return false;
+    std::vector<GuessMetrics> metrics(dict.size());
+    for (int guess = 0; guess < dict.size(); ++guess) {
+        const EmbeddedGuessMetrics& opener = embedded->opener[guess];
+        metrics[guess].guess = guess;
+        metrics[guess].isCandidate = opener.isCandidate;
+        metrics[guess].entropy = opener.entropy;
+        metrics[guess].worstBucket = opener.worstBucket;
+        metrics[guess].expectedSize = opener.expectedSize;
+    }
+    CandidateSet answers = dict.allAnswers();
+    for (RankingMode mode : {RankingMode::Entropy, RankingMode::Minimax, RankingMode::ExpectedSize}) {
+        cache.store(answers, mode, GuessRanking(metrics, GuessOrder{mode}));
+    }
+    // Lookahead: its scored leaders head the ranking, as rankGuesses leaves them
+    std::vector<GuessMetrics> items;
+    std::vector<bool> inHead(dict.size(), false);
+    for (int i = 0; i < embedded->lookaheadCount; ++i) {
+        const EmbeddedLookahead& leader = embedded->lookahead[i];
+        GuessMetrics m = metrics[leader.guess];
+        m.lookaheadSize = leader.lookaheadSize;
+        m.lookaheadBound = leader.lookaheadBound;
+        items.push_back(m);
+        inHead[leader.guess] = true;
+    }
+    for (const GuessMetrics& m : metrics) {
+        if (!inHead[m.guess]) items.push_back(m);
+    }
+    cache.store(answers, RankingMode::Lookahead, GuessRanking(std::move(items), GuessOrder{RankingMode::Lookahead}, embedded->lookaheadCount));
+    return true;
+}
+
+SolverDictionary loadSolverDictionary(const DictionarySources& sources, DictionaryLoadReport& report) {
+    SolverDictionary dict;
+    if (sources.embedded && embeddedDictionary()) {
+        auto started = std::chrono::steady_clock::now();
+        dict = dictionaryFromEmbedded(*embeddedDictionary());
+        report.accepted = dict.size();
+        report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        return dict;
+    }
+    if (!sources.binaryPath.empty()) {
+        auto started = std::chrono::steady_clock::now();
+        if (readBinaryDictionary(sources.binaryPath, dict, report.error)) {
+            report.accepted = dict.size();
+            report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+            return dict;
+        }
+        return SolverDictionary();
+    }
+    SolverAlphabet alphabet;
+    std::vector<uint32_t> answers, accepted;
+    if (!ingestWordSource(sources.answersPath, alphabet, answers, report)) return dict;
+    // A missing accepted list still leaves a playable answer-only dictionary
+    DictionaryLoadReport acceptedReport;
+    if (ingestWordSource(sources.acceptedPath, alphabet, accepted, acceptedReport)) report.add(acceptedReport);
+    std::vector<uint8_t> remap = alphabet.sortSymbols();
+    canonicalizeKeys(answers, remap, report);
+    canonicalizeKeys(accepted, remap, report);
+    dict = dictionaryFromKeys(alphabet, answers, accepted);
+    // Accepted words that are also answers are kept once, as answers
+    report.duplicates += answers.size() + accepted.size() - dict.size();
+    report.accepted = dict.size();
+    return dict;
+}
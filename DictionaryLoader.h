@@ -0,0 +1,102 @@
+#ifndef DICTIONARYLOADER_H
+#define DICTIONARYLOADER_H
+
+#include "SolverCore.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Where the word lists come from. By default the lists compiled into the binary;
+// otherwise text sources may be plain or gzip'ed files of any size, and binaryPath,
+// when set, points at a dictionary written by writeBinaryDictionary and takes
+// precedence over the text lists.
+struct DictionarySources {
+    std::string answersPath = "WordList.txt";
+    std::string acceptedPath = "AcceptedWordList";
+    std::string binaryPath;
+    bool embedded = true; // use the compiled-in lists when the build has them
+};
+
+// Overrides from --answers/--accepted/--dictionary, falling back to the
+// WORDLE_ANSWERS/WORDLE_ACCEPTED/WORDLE_DICTIONARY environment variables; any
+// override turns off the compiled-in lists
+DictionarySources dictionarySourcesFromArgs(int argc, char *argv[]);
+void setDefaultDictionarySources(const DictionarySources& sources);
+const DictionarySources& defaultDictionarySources();
+
+struct DictionaryLoadReport {
+    size_t bytes = 0;
+    size_t lines = 0;           // non-blank lines seen
+    size_t accepted = 0;        // words in the resulting dictionary
+    size_t rejectedLength = 0;
+    size_t rejectedAlphabet = 0;
+    size_t duplicates = 0;
+    double seconds = 0.0;
+    std::vector<std::string> rejectedSamples; // first few offending lines
+    std::string error;
+
+    double linesPerSecond() const { return seconds > 0.0 ? lines / seconds : 0.0; }
+    void add(const DictionaryLoadReport& other);
+};
+
+// Words are packed into 30-bit keys, six bits of dense letter index per position
+// with the first letter most significant, so numeric order is alphabetical order.
+uint32_t packWordKey(const PackedWord& word);
+PackedWord unpackWordKey(uint32_t key);
+
+// Reads and validates one word source (UTF-8, plain or gzip). New letters are added
+// to alphabet in order of appearance; keys come back unsorted and may repeat.
+bool ingestWordSource(const std::string& path, SolverAlphabet& alphabet, std::vector<uint32_t>& keys, DictionaryLoadReport& report);
+
+// Remaps keys after alphabet.sortSymbols(), then radix-sorts and deduplicates them
+// (counted in report.duplicates)
+void canonicalizeKeys(std::vector<uint32_t>& keys, const std::vector<uint8_t>& remap, DictionaryLoadReport& report);
+
+// Answers first, then accepted words that are not answers; both lists canonical
+SolverDictionary dictionaryFromKeys(const SolverAlphabet& alphabet, const std::vector<uint32_t>& answers, const std::vector<uint32_t>& accepted);
+
+bool writeBinaryDictionary(const std::string& path, const SolverDictionary& dict, std::string& error);
+bool readBinaryDictionary(const std::string& path, SolverDictionary& dict, std::string& error);
+
+// Loads the compiled-in lists unless sources override them, then the binary
+// dictionary if one is configured, otherwise ingests the text lists
+SolverDictionary loadSolverDictionary(const DictionarySources& sources, DictionaryLoadReport& report);
+
+// ============================================================================
+// Compiled-in dictionary
+// ============================================================================
+
+// The default lists in binary-dictionary form plus their opening rankings, written
+// at build time by EmbedDictionary (see CMakeLists.txt) as constant arrays
+struct EmbeddedGuessMetrics {
+    double entropy;
+    int worstBucket;
+    double expectedSize;
+    bool isCandidate;
+};
+
+struct EmbeddedLookahead {
+    int guess;
+    double lookaheadSize;
+    bool lookaheadBound;
+};
+
+struct EmbeddedDictionary {
+    const uint32_t *alphabet; // code points in dense letter order
+    int alphabetSize;
+    const uint32_t *keys;     // packWordKey per word, answers first
+    int answerCount;
+    int wordCount;
+    const EmbeddedGuessMetrics *opener; // by word, scored against every answer
+    const EmbeddedLookahead *lookahead; // the two-step leaders, best first
+    int lookaheadCount;
+};
+
+// nullptr when the build has no compiled-in lists
+const EmbeddedDictionary *embeddedDictionary();
+
+// Stores the compiled-in opening rankings (every mode but the heuristic) in cache,
+// provided dict is the compiled-in dictionary; true if it was
+bool seedOpenerRankings(const SolverDictionary& dict, SolverCache& cache);
+
+#endif // DICTIONARYLOADER_H
@@ -0,0 +1,86 @@
+#include "DictionaryLoader.h"
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+// Build step behind embeddedDictionary(): loads the word lists, ranks every opener
+// against every answer and writes both out as constant arrays, so the executables
+// start without reading or parsing a list.
+//   EmbedDictionary ANSWERS ACCEPTED OUTPUT.cpp
+
+namespace {
+
+const int VALUES_PER_LINE = 8;
+
+std::string formatDouble(double value) {
+    if (std::isinf(value)) return "std::numeric_limits<double>::infinity()";
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.17g", value); // round-trips exactly
+    return text;
+}
+
+void writeArray(std::FILE *out, const char *name, const std::vector<uint32_t>& values) {
+    std::fprintf(out, "constexpr uint32_t %s[] = {", name);
+    for (size_t i = 0; i < values.size(); ++i) {
+        std::fprintf(out, "%s0x%08x,", i % VALUES_PER_LINE == 0 ? "\n    " : " ", values[i]);
+    }
+    std::fprintf(out, "\n};\n\n");
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    if (argc != 4) {
+        std::cerr << "Usage: EmbedDictionary ANSWERS ACCEPTED OUTPUT.cpp" << std::endl;
+        return 2;
+    }
+    DictionarySources sources;
+    sources.answersPath = argv[1];
+    sources.acceptedPath = argv[2];
+    sources.embedded = false;
+    DictionaryLoadReport report;
+    SolverDictionary dict = loadSolverDictionary(sources, report);
+    if (dict.answerCount == 0) {
+        std::cerr << (report.error.empty() ? "No valid answer words" : report.error) << std::endl;
+        return 1;
+    }
+
+    CandidateList answers = dict.allAnswers().toList();
+    std::vector<GuessMetrics> opener(dict.size());
+    for (const GuessMetrics& m : rankGuesses(dict, answers, RankingMode::Entropy, 1).page(0, dict.size())) opener[m.guess] = m;
+    std::vector<GuessMetrics> leaders = rankGuesses(dict, answers, RankingMode::Lookahead, LOOKAHEAD_WIDTH).page(0, LOOKAHEAD_WIDTH);
+    std::erase_if(leaders, [](const GuessMetrics& m) { return std::isinf(m.lookaheadSize); });
+
+    std::FILE *out = std::fopen(argv[3], "w");
+    if (!out) {
+        std::cerr << "Could not write " << argv[3] << std::endl;
+        return 1;
+    }
+    std::fprintf(out, "// Generated by EmbedDictionary from %s and %s; do not edit\n", argv[1], argv[2]);
+    std::fprintf(out, "#include \"DictionaryLoader.h\"\n#include <limits>\n\nnamespace {\n\n");
+    std::vector<uint32_t> symbols, keys;
+    for (int i = 0; i < dict.alphabet.size(); ++i) symbols.push_back(static_cast<uint32_t>(dict.alphabet.symbol(i)));
+    for (const PackedWord& word : dict.packed) keys.push_back(packWordKey(word));
+    writeArray(out, "ALPHABET", symbols);
+    writeArray(out, "KEYS", keys);
+    std::fprintf(out, "constexpr EmbeddedGuessMetrics OPENER[] = {\n");
+    for (const GuessMetrics& m : opener) {
+        std::fprintf(out, "    {%s, %d, %s, %s},\n", formatDouble(m.entropy).c_str(), m.worstBucket, formatDouble(m.expectedSize).c_str(),
+                     m.isCandidate ? "true" : "false");
+    }
+    std::fprintf(out, "};\n\nconstexpr EmbeddedLookahead LOOKAHEAD[] = {\n");
+    for (const GuessMetrics& m : leaders) {
+        std::fprintf(out, "    {%d, %s, %s},\n", m.guess, formatDouble(m.lookaheadSize).c_str(), m.lookaheadBound ? "true" : "false");
+    }
+    std::fprintf(out, "};\n\nconstexpr EmbeddedDictionary EMBEDDED = {ALPHABET, %d, KEYS, %d, %d, OPENER, LOOKAHEAD, %d};\n\n} // namespace\n\n",
+                 dict.alphabet.size(), dict.answerCount, dict.size(), static_cast<int>(leaders.size()));
+    std::fprintf(out, "const EmbeddedDictionary *embeddedDictionary() {\n    return &EMBEDDED;\n}\n");
+    bool ok = std::ferror(out) == 0;
+    ok = std::fclose(out) == 0 && ok;
+    if (!ok) {
+        std::cerr << "Short write to " << argv[3] << std::endl;
+        return 1;
+    }
+    return 0;
+}
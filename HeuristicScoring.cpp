@@ -0,0 +1,221 @@
+#include "HeuristicScoring.h"
+#include <bit>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+// ============================================================================
+// Profiles
+// ============================================================================
+
+const std::array<ScoringProfileField, 4> SCORING_PROFILE_FIELDS = {{
+    {"unique-bonus", &ScoringProfile::uniqueLetterBonus},
+    {"yellow-bonus", &ScoringProfile::yellowLetterBonus},
+    {"repeat-penalty", &ScoringProfile::repeatPenalty},
+    {"yellow-repeat-penalty", &ScoringProfile::yellowRepeatPenalty},
+}};
+
+bool loadScoringProfile(const std::string& path, ScoringProfile& profile, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "Cannot open " + path;
+        return false;
+    }
+    ScoringProfile loaded;
+    std::string line;
+    for (int lineNumber = 1; std::getline(in, line); ++lineNumber) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string name, extra;
+        long long value;
+        if (!(fields >> name)) continue;
+        auto field = std::find_if(SCORING_PROFILE_FIELDS.begin(), SCORING_PROFILE_FIELDS.end(),
+                                  [&name](const ScoringProfileField& f) { return name == f.name; });
+        if (field == SCORING_PROFILE_FIELDS.end()) {
+            error = path + ":" + std::to_string(lineNumber) + ": unknown setting " + name;
+            return false;
+        }
+        if (!(fields >> value) || fields >> extra || value < 0 || value > 1000000) {
+            error = path + ":" + std::to_string(lineNumber) + ": " + name + " needs a whole number from 0 to 1000000";
+            return false;
+        }
+        loaded.*field->member = static_cast<int>(value);
+    }
+    profile = loaded;
+    return true;
+}
+
+bool saveScoringProfile(const std::string& path, const ScoringProfile& profile, std::string& error) {
+    std::ofstream out(path);
+    for (const ScoringProfileField& field : SCORING_PROFILE_FIELDS) {
+        out << field.name << " " << profile.*field.member << "\n";
+    }
+    if (!out.flush()) {
+        error = "Cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+bool scoringProfileFromArgs(int argc, char *argv[], ScoringProfile& profile, std::string& error) {
+    std::string path;
+    if (const char *env = std::getenv("WORDLE_PROFILE")) path = env;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--profile") path = argv[++i];
+    }
+    profile = ScoringProfile();
+    return path.empty() || loadScoringProfile(path, profile, error);
+}
+
+static ScoringProfile& defaultProfile() {
+    static ScoringProfile profile;
+    return profile;
+}
+
+void setDefaultScoringProfile(const ScoringProfile& profile) {
+    defaultProfile() = profile;
+}
+
+const ScoringProfile& defaultScoringProfile() {
+    return defaultProfile();
+}
+
+// ============================================================================
+// Scorer
+// ============================================================================
+
+HeuristicScorer::HeuristicScorer(const SolverDictionary& dict, const ScoringProfile& profile, FrequencySource source)
+    : dict(dict), profile(profile), positionScore(dict.size()), letters(dict.size()), distinct(dict.size()) {
+    std::vector<std::array<int, WORD_LENGTH>> frequency(MAX_ALPHABET_SIZE);
+    int counted = source == FrequencySource::AllWords ? dict.size() : dict.answerCount;
+    for (int a = 0; a < counted; ++a) {
+        for (int i = 0; i < WORD_LENGTH; ++i) frequency[dict.packed[a][i]][i]++;
+    }
+    for (int w = 0; w < dict.size(); ++w) {
+        const PackedWord& word = dict.packed[w];
+        for (int i = 0; i < WORD_LENGTH; ++i) {
+            positionScore[w] += frequency[word[i]][i];
+            letters[w] |= LetterMask(1) << word[i];
+        }
+        distinct[w] = static_cast<uint8_t>(std::popcount(letters[w]));
+    }
+    startingWord = bestGuess(SolverConstraints());
+}
+
+int HeuristicScorer::score(int word, const SolverConstraints& constraints) const {
+    int yellowUsed = std::popcount(letters[word] & constraints.yellowLetters);
+    int repeated = WORD_LENGTH - distinct[word];
+    int score = positionScore[word] + yellowUsed * profile.yellowLetterBonus;
+    // Repeats are cheaper when they come from chasing yellow letters
+    score -= repeated * (yellowUsed > 0 ? profile.yellowRepeatPenalty : profile.repeatPenalty);
+    score += distinct[word] * profile.uniqueLetterBonus;
+    return score;
+}
+
+int HeuristicScorer::bestGuess(const SolverConstraints& constraints, const CandidateSet *exclude) const {
+    bool starting = constraints.isEmpty();
+    if (starting && startingWord >= 0 && (!exclude || !exclude->contains(startingWord))) return startingWord;
+    int best = -1;
+    int bestScore = 0;
+    for (int w = 0; w < dict.size(); ++w) {
+        if (exclude && exclude->contains(w)) continue;
+        if (starting ? distinct[w] < WORD_LENGTH : !matchesConstraints(dict.packed[w], constraints)) continue;
+        int wordScore = score(w, constraints);
+        if (best < 0 || wordScore > bestScore || (wordScore == bestScore && dict.words[w] < dict.words[best])) {
+            best = w;
+            bestScore = wordScore;
+        }
+    }
+    return best;
+}
+
+std::vector<int> HeuristicScorer::topGuesses(const SolverConstraints& constraints, int count) const {
+    bool starting = constraints.isEmpty();
+    std::vector<std::pair<int, int>> scored; // score, word
+    for (int w = 0; w < dict.size(); ++w) {
+        if (starting ? distinct[w] < WORD_LENGTH : !matchesConstraints(dict.packed[w], constraints)) continue;
+        scored.emplace_back(score(w, constraints), w);
+    }
+    auto better = [this](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        return a.first != b.first ? a.first > b.first : dict.words[a.second] < dict.words[b.second];
+    };
+    size_t head = std::min(scored.size(), static_cast<size_t>(std::max(0, count)));
+    std::partial_sort(scored.begin(), scored.begin() + head, scored.end(), better);
+    std::vector<int> best;
+    for (size_t i = 0; i < head; ++i) best.push_back(scored[i].second);
+    return best;
+}
+
+// ============================================================================
+// Simulation
+// ============================================================================
+
+void addFeedback(SolverConstraints& constraints, const PackedWord& guess, uint8_t pattern) {
+    LetterMask present = constraints.yellowLetters;
+    LetterMask gray = 0;
+    int digits = pattern;
+    for (int i = 0; i < WORD_LENGTH; ++i, digits /= 3) {
+        LetterMask bit = LetterMask(1) << guess[i];
+        if (digits % 3 == 2) {
+            constraints.green[i] = guess[i];
+            present |= bit;
+        } else if (digits % 3 == 1) {
+            constraints.yellowForbidden[i] |= bit;
+            constraints.yellowLetters |= bit;
+            present |= bit;
+        } else {
+            gray |= bit;
+        }
+    }
+    for (int i = 0; i < WORD_LENGTH; ++i) {
+        if (constraints.green[i] >= 0) present |= LetterMask(1) << constraints.green[i];
+    }
+    // A gray copy of a letter that is green or yellow elsewhere only caps its count
+    constraints.grayLetters |= gray & ~present;
+}
+
+int playHeuristicGame(const HeuristicScorer& scorer, int answer, std::vector<double> *moveSeconds) {
+    const SolverDictionary& dict = scorer.dictionary();
+    SolverConstraints constraints;
+    CandidateSet guessed(dict.size());
+    for (int turn = 1; turn <= MAX_GUESSES; ++turn) {
+        auto start = std::chrono::steady_clock::now();
+        int guess = scorer.bestGuess(constraints, &guessed);
+        if (moveSeconds) moveSeconds->push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        if (guess < 0) break;
+        if (guess == answer) return turn;
+        guessed.insert(guess);
+        addFeedback(constraints, dict.packed[guess], computeFeedback(dict.packed[guess], dict.packed[answer]));
+    }
+    return MAX_GUESSES + 1;
+}
+
+void GameTally::add(const GameTally& other) {
+    for (size_t g = 0; g < games.size(); ++g) games[g] += other.games[g];
+}
+
+int GameTally::played() const {
+    int total = 0;
+    for (int count : games) total += count;
+    return total;
+}
+
+double GameTally::meanGuesses() const {
+    int total = played();
+    if (total == 0) return 0.0;
+    long long guesses = 0;
+    for (size_t g = 0; g < games.size(); ++g) guesses += static_cast<long long>(g) * games[g];
+    return static_cast<double>(guesses) / total;
+}
+
+bool GameTally::betterThan(const GameTally& other) const {
+    if (meanGuesses() != other.meanGuesses()) return meanGuesses() < other.meanGuesses();
+    return losses() < other.losses();
+}
+
+GameTally playHeuristicGames(const HeuristicScorer& scorer, int begin, int end) {
+    GameTally tally;
+    for (int answer = begin; answer < end; ++answer) tally.add(playHeuristicGame(scorer, answer));
+    return tally;
+}
@@ -0,0 +1,97 @@
+#ifndef HEURISTICSCORING_H
+#define HEURISTICSCORING_H
+
+#include "SolverCore.h"
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+// The letter-frequency heuristic of getAllValidWordsWithConstraints on packed words,
+// so strategies can be simulated and tuned without Qt. Position frequencies come
+// from the answer list; the constants below are the defaults and can be replaced
+// by a profile file (see the tune command for producing one).
+struct ScoringProfile {
+    int uniqueLetterBonus = 2000;   // per distinct letter
+    int yellowLetterBonus = 5000;   // per known-present letter the guess uses
+    int repeatPenalty = 10000;      // per repeated letter
+    int yellowRepeatPenalty = 1000; // per repeated letter when yellow letters are used
+
+    bool operator==(const ScoringProfile& other) const = default;
+};
+
+// Names used in profile files and for the matching command-line options
+struct ScoringProfileField {
+    const char *name;
+    int ScoringProfile::*member;
+};
+extern const std::array<ScoringProfileField, 4> SCORING_PROFILE_FIELDS;
+
+// Profile files hold one "name value" pair per line; # starts a comment and names
+// that are left out keep their default
+bool loadScoringProfile(const std::string& path, ScoringProfile& profile, std::string& error);
+bool saveScoringProfile(const std::string& path, const ScoringProfile& profile, std::string& error);
+
+// The profile named by --profile FILE or WORDLE_PROFILE, else the built-in one
+bool scoringProfileFromArgs(int argc, char *argv[], ScoringProfile& profile, std::string& error);
+
+// Profile the solver window scores with; set once at startup
+void setDefaultScoringProfile(const ScoringProfile& profile);
+const ScoringProfile& defaultScoringProfile();
+
+// Words the position frequencies are counted over: the answers for the solver window
+// and tuning, every word for the game window's hint
+enum class FrequencySource { Answers, AllWords };
+
+class HeuristicScorer {
+public:
+    HeuristicScorer(const SolverDictionary& dict, const ScoringProfile& profile, FrequencySource source = FrequencySource::Answers);
+
+    const SolverDictionary& dictionary() const { return dict; }
+    const ScoringProfile& scoringProfile() const { return profile; }
+
+    // Score of a word that matches constraints; higher is better
+    int score(int word, const SolverConstraints& constraints) const;
+    // Best word by score (ties alphabetical) among those that match constraints and
+    // are not in exclude. With no constraints only words of distinct letters qualify,
+    // as for the starting-word list. -1 if nothing matches.
+    int bestGuess(const SolverConstraints& constraints, const CandidateSet *exclude = nullptr) const;
+    // The count best words under the same rules, best first: the solver window's list
+    std::vector<int> topGuesses(const SolverConstraints& constraints, int count) const;
+
+private:
+    const SolverDictionary& dict;
+    ScoringProfile profile;
+    std::vector<int> positionScore; // sum of answer frequencies of the word's letters by position
+    std::vector<LetterMask> letters;
+    std::vector<uint8_t> distinct;
+    int startingWord = -1;
+};
+
+// Folds one row of feedback into constraints the way a player enters it in the
+// solver window: greens by square, yellows with the squares they were seen on, and
+// grays only for letters not known to be present
+void addFeedback(SolverConstraints& constraints, const PackedWord& guess, uint8_t pattern);
+
+// Guesses taken to solve answer, or MAX_GUESSES + 1 for a loss. moveSeconds, if
+// given, gets the time each guess took to choose.
+int playHeuristicGame(const HeuristicScorer& scorer, int answer, std::vector<double> *moveSeconds = nullptr);
+
+// Games by guess count: index g holds games solved in g guesses, index MAX_GUESSES + 1 losses
+struct GameTally {
+    std::array<int, MAX_GUESSES + 2> games{};
+
+    void add(int guesses) { games[std::min(guesses, MAX_GUESSES + 1)]++; }
+    void add(const GameTally& other);
+    int played() const;
+    int losses() const { return games[MAX_GUESSES + 1]; }
+    // Losses count as MAX_GUESSES + 1 guesses
+    double meanGuesses() const;
+    // Fewer guesses on average, then fewer losses
+    bool betterThan(const GameTally& other) const;
+};
+
+// Plays answers [begin, end) of the dictionary
+GameTally playHeuristicGames(const HeuristicScorer& scorer, int begin, int end);
+
+#endif // HEURISTICSCORING_H
@@ -0,0 +1,7 @@
+#include "DictionaryLoader.h"
+
+// Builds without compiled-in lists (and the EmbedDictionary step itself) read the
+// word list files
+const EmbeddedDictionary *embeddedDictionary() {
+    return nullptr;
+}
@@ -0,0 +1,612 @@
+#include "SolverCli.h"
+#include "DictionaryLoader.h"
+#include "SolverExport.h"
+#include "SolverKernels.h"
+#include "SolverProtocol.h"
+#include "SolverQuery.h"
+#include "SolverRegression.h"
+#include "SolverReverse.h"
+#include "SolverSweep.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+static std::string optionValue(int argc, char *argv[], const std::string &name, const std::string &fallback = std::string()) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (name == argv[i]) return argv[i + 1];
+    }
+    return fallback;
+}
+
+// Comma-separated integers, e.g. "1000,2000,4000"
+static bool parseIntList(const std::string &text, std::vector<int> &values) {
+    std::istringstream in(text);
+    std::string item;
+    values.clear();
+    while (std::getline(in, item, ',')) {
+        try {
+            size_t used = 0;
+            values.push_back(std::stoi(item, &used));
+            if (used != item.size()) return false;
+        } catch (const std::exception &) {
+            return false;
+        }
+    }
+    return !values.empty();
+}
+
+static void printUsage() {
+    std::cout << "Usage: Wordle_Calculator_Headless <command> [options]\n"
+              << "\n"
+              << "Commands:\n"
+              << "  compile-dictionary --output FILE   Validate, dedup and sort the word lists into a binary dictionary\n"
+              << "  sweep [options]                    Play every answer with each combination of heuristic constants\n"
+              << "  tune [--output FILE] [options]     Search for heuristic constants with the fewest average guesses\n"
+              << "  regression-report [options]        Play every answer with each strategy and compare against a baseline\n"
+              << "  export-lines --output FILE         Precompute every answer's play line with the top alternatives per step\n"
+              << "  serve [--profile FILE]             Answer NEW/GUESS/HINT/CANDIDATES requests on stdin (the default with no command)\n"
+              << "  query QUERY [options]              List the words matching a query such as \"?R?N? +E -ST A=0-1\"\n"
+              << "  reverse --answer WORD [options]    List the words that could have made each row of a shared grid (read from stdin)\n"
+              << "  rank [options]                     Rank opening guesses over every answer, exactly or by sampling\n"
+              << "  check-kernels                      Compare each vector feedback kernel this CPU runs against the scalar one\n"
+              << "\n"
+              << "Sweep options (each LIST is comma-separated; defaults come from --profile or the built-in constants):\n"
+              << "  --unique-bonus LIST           Score per distinct letter\n"
+              << "  --yellow-bonus LIST           Score per yellow letter used\n"
+              << "  --repeat-penalty LIST         Penalty per repeated letter\n"
+              << "  --yellow-repeat-penalty LIST  Penalty per repeated letter when yellow letters are used\n"
+              << "  --workers N                   Worker processes (default: one per core; 0 = threads in this process)\n"
+              << "  --shard-size N                Answers per work item (default 256)\n"
+              << "  --checkpoint FILE             Record finished work and resume from it after an interruption\n"
+              << "  --top N                       Profiles to print, best first (default 20)\n"
+              << "\n"
+              << "Tune options (plus --workers and --shard-size):\n"
+              << "  --profile FILE                Starting constants (also WORDLE_PROFILE)\n"
+              << "  --output FILE                 Write the best constants as a profile file\n"
+              << "  --rounds N                    Most search rounds (default 20)\n"
+              << "  --min-step N                  Stop once every step is below N (default 50)\n"
+              << "\n"
+              << "Regression report options:\n"
+              << "  --baseline FILE               Fail (exit 1) when a strategy regresses beyond the file's tolerances\n"
+              << "  --write-baseline FILE         Write the measured results, keeping the baseline's tolerances\n"
+              << "  --strategies LIST             Comma-separated subset of heuristic,entropy,minimax,expected-size,lookahead\n"
+              << "\n"
+              << "Export options:\n"
+              << "  --mode NAME                   entropy (default), minimax, expected-size or lookahead\n"
+              << "  --alternatives K              Ranked guesses stored per step (default 5)\n"
+              << "\n"
+              << "Query options (QUERY tokens: a pattern like ?R?N?, +LETTERS, -LETTERS, L=N, L=MIN-MAX, L=MIN-):\n"
+              << "  --answers-only                Match answers only, not accepted guesses\n"
+              << "  --limit N                     Words to print (default all)\n"
+              << "\n"
+              << "Reverse options:\n"
+              << "  --grid FILE                   Read the grid from FILE instead of stdin\n"
+              << "  --limit N                     Words listed per row (default 20, 0 = all)\n"
+              << "  --budget N                    Search states for counting consistent sequences (default 2000000, 0 = skip)\n"
+              << "\n"
+              << "Rank options:\n"
+              << "  --mode NAME                   entropy (default), minimax, expected-size or lookahead\n"
+              << "  --top N                       Guesses to print (default 10)\n"
+              << "  --sampled                     Successive halving over candidate samples instead of exact scores\n"
+              << "  --sample N                    First round's sample size (default 512)\n"
+              << "  --keep-factor N               Survivors are divided by N each round (default 2)\n"
+              << "  --compare                     With --sampled, also rank exactly and report how many of the top N agree\n"
+              << "\n"
+              << "Dictionary options (all commands; without any, the lists compiled into the binary):\n"
+              << "  --answers FILE      Answer list, plain or gzip (default WordList.txt, env WORDLE_ANSWERS)\n"
+              << "  --accepted FILE     Accepted guesses, plain or gzip (default AcceptedWordList, env WORDLE_ACCEPTED)\n"
+              << "  --dictionary FILE   Binary dictionary to use instead of the lists (env WORDLE_DICTIONARY)\n";
+}
+
+static void printLoadReport(const DictionaryLoadReport &report) {
+    std::cerr << "Read " << report.lines << " lines (" << report.bytes / 1024 << " KiB) in " << report.seconds << " s, "
+              << static_cast<long long>(report.linesPerSecond()) << " lines/s\n"
+              << "Kept " << report.accepted << " words; rejected " << report.rejectedLength << " for length, "
+              << report.rejectedAlphabet << " for alphabet; dropped " << report.duplicates << " duplicates\n";
+    for (const std::string &sample : report.rejectedSamples) {
+        std::cerr << "  rejected: " << sample << "\n";
+    }
+}
+
+static int compileDictionary(int argc, char *argv[]) {
+    std::string output = optionValue(argc, argv, "--output");
+    if (output.empty()) {
+        std::cerr << "compile-dictionary needs --output FILE" << std::endl;
+        return 2;
+    }
+    DictionarySources sources = dictionarySourcesFromArgs(argc, argv);
+    DictionaryLoadReport report;
+    SolverDictionary dict = loadSolverDictionary(sources, report);
+    printLoadReport(report);
+    if (dict.answerCount == 0) {
+        std::cerr << (report.error.empty() ? "No valid answer words" : report.error) << std::endl;
+        return 1;
+    }
+    std::string error;
+    if (!writeBinaryDictionary(output, dict, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    std::cerr << "Wrote " << dict.answerCount << " answers and " << dict.size() - dict.answerCount << " accepted words to " << output << std::endl;
+    return 0;
+}
+
+static bool sweepOptionsFromArgs(int argc, char *argv[], SweepOptions &options) {
+    try {
+        options.workers = std::stoi(optionValue(argc, argv, "--workers", std::to_string(std::max(1u, std::thread::hardware_concurrency()))));
+        options.shardSize = std::stoi(optionValue(argc, argv, "--shard-size", "256"));
+    } catch (const std::exception &) {
+        std::cerr << "--workers and --shard-size take numbers" << std::endl;
+        return false;
+    }
+    options.checkpointPath = optionValue(argc, argv, "--checkpoint");
+    return true;
+}
+
+static bool loadAnswers(int argc, char *argv[], SolverDictionary &dict) {
+    DictionaryLoadReport report;
+    dict = loadSolverDictionary(dictionarySourcesFromArgs(argc, argv), report);
+    if (dict.answerCount == 0) {
+        printLoadReport(report);
+        std::cerr << (report.error.empty() ? "No valid answer words" : report.error) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Scratch arena use since resetSolverArenaStats(): how big the search temporaries got
+static void printArenaStats() {
+    ArenaStats stats = solverArenaStats();
+    std::cerr << "arena: peak " << stats.peakBytes / 1024 << " KiB on one thread, " << stats.reservedBytes / 1024 << " KiB held, "
+              << stats.upstreamAllocations << " chunks allocated" << std::endl;
+}
+
+static void printProfileRow(const char *label, const SweepResult &result) {
+    std::printf("%4s  %6.3f  %6d", label, result.tally.meanGuesses(), result.tally.losses());
+    for (const ScoringProfileField &field : SCORING_PROFILE_FIELDS) std::printf("  %8d", result.profile.*field.member);
+    std::printf("\n");
+}
+
+static int sweep(int argc, char *argv[]) {
+    ScoringProfile defaults;
+    std::string error;
+    if (!scoringProfileFromArgs(argc, argv, defaults, error)) {
+        std::cerr << error << std::endl;
+        return 2;
+    }
+    // Every combination of the per-constant value lists
+    std::vector<ScoringProfile> profiles = {defaults};
+    for (const ScoringProfileField &field : SCORING_PROFILE_FIELDS) {
+        std::string option = std::string("--") + field.name;
+        std::string list = optionValue(argc, argv, option, std::to_string(defaults.*field.member));
+        std::vector<int> values;
+        if (!parseIntList(list, values)) {
+            std::cerr << "Bad value list for " << option << ": " << list << std::endl;
+            return 2;
+        }
+        std::vector<ScoringProfile> expanded;
+        for (const ScoringProfile &profile : profiles) {
+            for (int value : values) {
+                ScoringProfile next = profile;
+                next.*field.member = value;
+                expanded.push_back(next);
+            }
+        }
+        profiles = expanded;
+    }
+
+    SweepOptions options;
+    int top = 20;
+    try {
+        top = std::stoi(optionValue(argc, argv, "--top", "20"));
+    } catch (const std::exception &) {
+        std::cerr << "--top takes a number" << std::endl;
+        return 2;
+    }
+    if (!sweepOptionsFromArgs(argc, argv, options)) return 2;
+    SolverDictionary dict;
+    if (!loadAnswers(argc, argv, dict)) return 1;
+    std::cerr << "Sweeping " << profiles.size() << " profiles over " << dict.answerCount << " answers" << std::endl;
+
+    std::vector<SweepResult> results;
+    bool ok = runSweep(dict, profiles, options, results, error, [](int done, int total) {
+        std::cerr << "\r" << done << "/" << total << " shards" << std::flush;
+    });
+    std::cerr << std::endl;
+    if (!ok) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    std::stable_sort(results.begin(), results.end(), [](const SweepResult &a, const SweepResult &b) {
+        return a.tally.betterThan(b.tally);
+    });
+    std::printf("%4s  %6s  %6s  %8s  %8s  %8s  %8s\n", "rank", "mean", "losses", "unique", "yellow", "repeat", "yrepeat");
+    for (int i = 0; i < std::min<int>(top, static_cast<int>(results.size())); ++i) {
+        printProfileRow(std::to_string(i + 1).c_str(), results[i]);
+    }
+    return 0;
+}
+
+static int tune(int argc, char *argv[]) {
+    ScoringProfile start;
+    std::string error;
+    if (!scoringProfileFromArgs(argc, argv, start, error)) {
+        std::cerr << error << std::endl;
+        return 2;
+    }
+    std::string output = optionValue(argc, argv, "--output");
+    TuneOptions tuneOptions;
+    SweepOptions options;
+    try {
+        tuneOptions.maxRounds = std::stoi(optionValue(argc, argv, "--rounds", std::to_string(tuneOptions.maxRounds)));
+        tuneOptions.minStep = std::stoi(optionValue(argc, argv, "--min-step", std::to_string(tuneOptions.minStep)));
+    } catch (const std::exception &) {
+        std::cerr << "--rounds and --min-step take numbers" << std::endl;
+        return 2;
+    }
+    if (!sweepOptionsFromArgs(argc, argv, options)) return 2;
+    SolverDictionary dict;
+    if (!loadAnswers(argc, argv, dict)) return 1;
+
+    std::printf("%4s  %6s  %6s  %8s  %8s  %8s  %8s\n", "step", "mean", "losses", "unique", "yellow", "repeat", "yrepeat");
+    SweepResult best;
+    bool ok = tuneScoringProfile(dict, start, options, tuneOptions, best, error, [](int round, const SweepResult &result) {
+        printProfileRow(std::to_string(round).c_str(), result);
+        std::fflush(stdout);
+    });
+    if (!ok) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    printProfileRow("best", best);
+    if (!output.empty() && !saveScoringProfile(output, best.profile, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+static int regressionReport(int argc, char *argv[]) {
+    std::string baselinePath = optionValue(argc, argv, "--baseline");
+    std::string writePath = optionValue(argc, argv, "--write-baseline");
+    std::vector<std::string> strategies;
+    std::istringstream list(optionValue(argc, argv, "--strategies"));
+    for (std::string name; std::getline(list, name, ',');) strategies.push_back(name);
+    if (strategies.empty()) strategies = regressionStrategies();
+
+    RegressionBaseline baseline;
+    std::string error;
+    if (!baselinePath.empty() && !loadRegressionBaseline(baselinePath, baseline, error)) {
+        std::cerr << error << std::endl;
+        return 2;
+    }
+    ScoringProfile profile;
+    if (!scoringProfileFromArgs(argc, argv, profile, error)) {
+        std::cerr << error << std::endl;
+        return 2;
+    }
+    setDefaultScoringProfile(profile);
+    SolverDictionary dict;
+    if (!loadAnswers(argc, argv, dict)) return 1;
+
+    resetSolverArenaStats();
+    std::printf("%-14s  %6s  %8s  %10s  %8s  %6s\n", "strategy", "mean", "failures", "p99 ms", "relative", "moves");
+    std::vector<std::string> regressions;
+    for (const std::string &strategy : strategies) {
+        StrategyReport report;
+        if (!playStrategy(dict, strategy, report)) {
+            std::cerr << "Unknown strategy " << strategy << std::endl;
+            return 2;
+        }
+        std::printf("%-14s  %6.4f  %8.5f  %10.3f  %8.4f  %6d\n", strategy.c_str(), report.tally.meanGuesses(),
+                    report.failureRate(), report.p99MoveMs, report.p99Relative(), report.movesTimed);
+        std::fflush(stdout);
+        for (const std::string &regression : compareToBaseline(report, baseline)) regressions.push_back(regression);
+        baseline.record(report);
+    }
+    if (!writePath.empty() && !saveRegressionBaseline(writePath, baseline, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    printArenaStats();
+    for (const std::string &regression : regressions) std::cerr << "REGRESSION " << regression << std::endl;
+    return regressions.empty() ? 0 : 1;
+}
+
+static int exportLines(int argc, char *argv[]) {
+    std::string output = optionValue(argc, argv, "--output");
+    if (output.empty()) {
+        std::cerr << "export-lines needs --output FILE" << std::endl;
+        return 2;
+    }
+    LineExportOptions options;
+    std::string modeName = optionValue(argc, argv, "--mode", rankingModeName(options.mode));
+    if (!rankingModeFromName(modeName, options.mode) || options.mode == RankingMode::Heuristic) {
+        std::cerr << "--mode must be entropy, minimax, expected-size or lookahead" << std::endl;
+        return 2;
+    }
+    try {
+        options.alternatives = std::stoi(optionValue(argc, argv, "--alternatives", std::to_string(options.alternatives)));
+    } catch (const std::exception &) {
+        std::cerr << "--alternatives takes a number" << std::endl;
+        return 2;
+    }
+    SolverDictionary dict;
+    if (!loadAnswers(argc, argv, dict)) return 1;
+
+    resetSolverArenaStats();
+    auto start = std::chrono::steady_clock::now();
+    LineExportSummary summary;
+    std::string error;
+    if (!exportPlayLines(dict, options, output, summary, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << "Wrote " << dict.answerCount << " lines (" << summary.steps << " steps, " << summary.positions
+              << " positions ranked) to " << output << " in " << seconds << " s; mean " << summary.meanGuesses
+              << " guesses, longest " << summary.longestLine << std::endl;
+    printArenaStats();
+    return 0;
+}
+
+static int serve(int argc, char *argv[]) {
+    // Unsynced streams buffer on their own, so a pipelined batch is read and answered in bulk
+    std::ios::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+    ScoringProfile profile;
+    std::string error;
+    if (!scoringProfileFromArgs(argc, argv, profile, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    SolverDictionary dict;
+    if (!loadAnswers(argc, argv, dict)) return 1;
+    HeuristicScorer scorer(dict, profile);
+    return runSolverProtocol(scorer, std::cin, std::cout);
+}
+
+static int query(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "query needs a query, e.g. query \"?R?N? +E -ST\"" << std::endl;
+        return 2;
+    }
+    bool answersOnly = false;
+    for (int i = 3; i < argc; ++i) answersOnly = answersOnly || std::string(argv[i]) == "--answers-only";
+    int limit = 0;
+    try {
+        limit = std::stoi(optionValue(argc, argv, "--limit", "0"));
+    } catch (const std::exception &) {
+        std::cerr << "--limit takes a number" << std::endl;
+        return 2;
+    }
+    SolverDictionary dict;
+    if (!loadAnswers(argc, argv, dict)) return 1;
+    WordQuery wordQuery;
+    std::string error;
+    if (!parseWordQuery(dict.alphabet, argv[2], wordQuery, error)) {
+        std::cerr << error << std::endl;
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    WordIndex index = WordIndex::build(dict);
+    auto built = std::chrono::steady_clock::now();
+    CandidateSet matches = index.match(wordQuery, answersOnly ? dict.allAnswers() : CandidateSet::range(dict.size(), 0, dict.size()));
+    auto done = std::chrono::steady_clock::now();
+
+    int shown = 0;
+    matches.forEach([&](int word) {
+        if (limit <= 0 || shown++ < limit) std::cout << dict.words[word] << (word < dict.answerCount ? "" : " (accepted)") << '\n';
+    });
+    std::cerr << matches.count() << " matches; index built in " << std::chrono::duration<double, std::micro>(built - start).count()
+              << " us, query took " << std::chrono::duration<double, std::micro>(done - built).count() << " us" << std::endl;
+    return 0;
+}
+
+static int reverse(int argc, char *argv[]) {
+    std::string answerWord = optionValue(argc, argv, "--answer");
+    std::string gridPath = optionValue(argc, argv, "--grid");
+    int limit = 0;
+    long long budget = 0;
+    try {
+        limit = std::stoi(optionValue(argc, argv, "--limit", "20"));
+        budget = std::stoll(optionValue(argc, argv, "--budget", "2000000"));
+    } catch (const std::exception &) {
+        std::cerr << "--limit and --budget take numbers" << std::endl;
+        return 2;
+    }
+    if (answerWord.empty()) {
+        std::cerr << "reverse needs --answer WORD" << std::endl;
+        return 2;
+    }
+    SolverDictionary dict;
+    if (!loadAnswers(argc, argv, dict)) return 1;
+    std::u32string symbols;
+    std::string upper;
+    if (decodeUtf8(answerWord.data(), answerWord.data() + answerWord.size(), symbols)) {
+        for (char32_t symbol : symbols) appendUtf8(upper, foldToUpper(symbol));
+    }
+    int answer = dict.indexOf(upper);
+    if (answer < 0) {
+        std::cerr << "Not in the word list: " << answerWord << std::endl;
+        return 2;
+    }
+    std::stringstream grid;
+    if (gridPath.empty()) {
+        grid << std::cin.rdbuf();
+    } else {
+        std::ifstream in(gridPath);
+        if (!in) {
+            std::cerr << "Cannot read " << gridPath << std::endl;
+            return 1;
+        }
+        grid << in.rdbuf();
+    }
+    std::vector<uint8_t> patterns;
+    std::string error;
+    if (!parseShareGrid(grid.str(), patterns, error)) {
+        std::cerr << error << std::endl;
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    ReverseIndex index = ReverseIndex::build(dict, answer);
+    auto built = std::chrono::steady_clock::now();
+    ReverseSolution solution = reverseSolve(dict, index, patterns, budget);
+    auto done = std::chrono::steady_clock::now();
+
+    for (size_t row = 0; row < patterns.size(); ++row) {
+        const CandidateSet &words = solution.rowGuesses[row];
+        std::printf("%zu  %s  %5d", row + 1, patternToString(patterns[row]).c_str(), words.count());
+        int shown = 0;
+        words.forEach([&](int word) {
+            if (limit <= 0 || shown++ < limit) std::printf(" %s", dict.words[word].c_str());
+        });
+        std::printf("%s\n", limit > 0 && words.count() > limit ? " ..." : "");
+    }
+    std::printf("sequences of distinct words: %.0f\n", solution.sequences);
+    if (solution.consistentSequences >= 0) {
+        std::printf("each word consistent with the rows before it: %.0f\n", solution.consistentSequences);
+    } else if (budget > 0) {
+        std::printf("each word consistent with the rows before it: more than --budget %lld states to count\n", budget);
+    }
+    std::cerr << "index built in " << std::chrono::duration<double, std::milli>(built - start).count() << " ms, solved in "
+              << std::chrono::duration<double, std::milli>(done - built).count() << " ms" << std::endl;
+    return 0;
+}
+
+static bool hasFlag(int argc, char *argv[], const std::string &flag) {
+    for (int i = 2; i < argc; ++i) {
+        if (flag == argv[i]) return true;
+    }
+    return false;
+}
+
+static int rank(int argc, char *argv[]) {
+    RankingMode mode = RankingMode::Entropy;
+    if (!rankingModeFromName(optionValue(argc, argv, "--mode", rankingModeName(mode)), mode) || mode == RankingMode::Heuristic) {
+        std::cerr << "--mode must be entropy, minimax, expected-size or lookahead" << std::endl;
+        return 2;
+    }
+    int top = 0;
+    SampledRankingOptions options;
+    try {
+        top = std::stoi(optionValue(argc, argv, "--top", "10"));
+        options.initialSample = std::stoi(optionValue(argc, argv, "--sample", std::to_string(options.initialSample)));
+        options.keepFactor = std::stoi(optionValue(argc, argv, "--keep-factor", std::to_string(options.keepFactor)));
+    } catch (const std::exception &) {
+        std::cerr << "--top, --sample and --keep-factor take numbers" << std::endl;
+        return 2;
+    }
+    bool sampled = hasFlag(argc, argv, "--sampled");
+    SolverDictionary dict;
+    if (!loadAnswers(argc, argv, dict)) return 1;
+    CandidateList answers = dict.allAnswers().toList();
+    resetSolverArenaStats();
+
+    auto timed = [](auto rankNow, double &ms) {
+        auto start = std::chrono::steady_clock::now();
+        GuessRanking ranking = rankNow();
+        ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return ranking;
+    };
+    auto exactRanking = [&] { return rankGuesses(dict, answers, mode, top); };
+    double ms = 0.0;
+    SampledRankingReport report;
+    GuessRanking ranking = sampled ? timed([&] { return rankGuessesSampled(dict, answers, mode, top, options, report); }, ms)
+                                   : timed(exactRanking, ms);
+    std::vector<GuessMetrics> best = ranking.page(0, top);
+    std::printf("%-4s  %-8s  %8s  %6s  %9s\n", "rank", "guess", "entropy", "worst", "expected");
+    for (size_t i = 0; i < best.size(); ++i) {
+        std::printf("%-4zu  %-8s  %8.4f  %6d  %9.2f\n", i + 1, dict.words[best[i].guess].c_str(), best[i].entropy, best[i].worstBucket,
+                    best[i].expectedSize);
+    }
+    long long exactPairs = static_cast<long long>(dict.size()) * static_cast<long long>(answers.size());
+    if (!sampled) {
+        std::printf("exact: %lld pairs in %.1f ms\n", exactPairs, ms);
+        printArenaStats();
+        return 0;
+    }
+    std::printf("sampled: %d rounds, %d guesses scored exactly, %lld pairs (%.1f%% of exact) in %.1f ms, confidence %.3f\n",
+                report.rounds, report.exactGuesses, report.pairsScored, 100.0 * report.pairsScored / exactPairs, ms, report.confidence);
+    if (hasFlag(argc, argv, "--compare")) {
+        double exactMs = 0.0;
+        std::vector<GuessMetrics> exactBest = timed(exactRanking, exactMs).page(0, top);
+        int agree = 0;
+        for (const GuessMetrics &metrics : best) {
+            for (const GuessMetrics &other : exactBest) agree += metrics.guess == other.guess;
+        }
+        std::printf("exact: %.1f ms; %d of the top %zu agree, best %s\n", exactMs, agree, exactBest.size(),
+                    !best.empty() && !exactBest.empty() && best[0].guess == exactBest[0].guess ? "matches" : "differs");
+    }
+    printArenaStats();
+    return 0;
+}
+
+static int checkKernels(int argc, char *argv[]) {
+    // A mistyped cap in a CI job would otherwise quietly test the detected level
+    SimdLevel requested;
+    std::string error;
+    if (!requestedSimdLevel(requested, error)) {
+        std::cerr << error << std::endl;
+        return 2;
+    }
+    SolverDictionary dict;
+    if (!loadAnswers(argc, argv, dict)) return 1;
+    CandidateList answers = dict.allAnswers().toList();
+    LetterPlanes planes = LetterPlanes::gather(dict, answers);
+    const uint8_t *rows[WORD_LENGTH];
+    for (int i = 0; i < WORD_LENGTH; ++i) rows[i] = planes.letters[i].data();
+
+    std::printf("supported %s, active %s\n", simdLevelName(supportedSimdLevel()), simdLevelName(activeSimdLevel()));
+    int failures = 0;
+    std::vector<uint8_t> row(answers.size());
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        FeedbackRowKernel kernel = feedbackRowKernel(level);
+        if (!kernel) {
+            std::printf("%-7s  not available\n", simdLevelName(level));
+            continue;
+        }
+        long long mismatches = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int guess = 0; guess < dict.size(); ++guess) {
+            kernel(dict.packed[guess], rows, answers.size(), row.data());
+            for (size_t c = 0; c < answers.size(); ++c) {
+                if (row[c] == computeFeedback(dict.packed[guess], dict.packed[answers[c]])) continue;
+                if (mismatches++ < 5) {
+                    std::fprintf(stderr, "%s: %s vs %s gave %s, expected %s\n", simdLevelName(level), dict.words[guess].c_str(),
+                                 dict.words[answers[c]].c_str(), patternToString(row[c]).c_str(),
+                                 patternToString(computeFeedback(dict.packed[guess], dict.packed[answers[c]])).c_str());
+                }
+            }
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-7s  %s  %lld mismatches over %zu pairs, %.1f ms with checking\n", simdLevelName(level), mismatches ? "FAIL" : "ok",
+                    mismatches, static_cast<size_t>(dict.size()) * answers.size(), ms);
+        if (mismatches) ++failures;
+    }
+    return failures ? 1 : 0;
+}
+
+int runSolverCli(int argc, char *argv[]) {
+    std::string command = argc > 1 ? argv[1] : "";
+    if (command.empty() || command == "serve") return serve(argc, argv);
+    if (command == "compile-dictionary") return compileDictionary(argc, argv);
+    if (command == "sweep") return sweep(argc, argv);
+    if (command == "tune") return tune(argc, argv);
+    if (command == "regression-report") return regressionReport(argc, argv);
+    if (command == "export-lines") return exportLines(argc, argv);
+    if (command == "query") return query(argc, argv);
+    if (command == "reverse") return reverse(argc, argv);
+    if (command == "rank") return rank(argc, argv);
+    if (command == "check-kernels") return checkKernels(argc, argv);
+    printUsage();
+    return command == "help" || command == "--help" ? 0 : 2;
+}
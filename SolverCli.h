@@ -0,0 +1,8 @@
+#ifndef SOLVERCLI_H
+#define SOLVERCLI_H
+
+// Headless commands, e.g. `Wordle_Calculator_Headless compile-dictionary --output words.bin`.
+// Returns the process exit code.
+int runSolverCli(int argc, char *argv[]);
+
+#endif // SOLVERCLI_H
@@ -0,0 +1,1488 @@
+#include "SolverCore.h"
+#include "SolverKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+// ============================================================================
+// Alphabet
+// ============================================================================
+
+int SolverAlphabet::indexOf(char32_t symbol) const {
+    auto it = indexBySymbol.find(symbol);
+    return it == indexBySymbol.end() ? -1 : it->second;
+}
+
+int SolverAlphabet::add(char32_t symbol) {
+    int index = indexOf(symbol);
+    if (index >= 0) return index;
+    if (size() >= MAX_ALPHABET_SIZE) return -1;
+    index = size();
+    symbols.push_back(symbol);
+    indexBySymbol.emplace(symbol, index);
+    return index;
+}
+
+std::vector<uint8_t> SolverAlphabet::sortSymbols() {
+    std::vector<char32_t> sorted = symbols;
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<uint8_t> remap(symbols.size());
+    for (int i = 0; i < size(); ++i) {
+        remap[i] = static_cast<uint8_t>(std::lower_bound(sorted.begin(), sorted.end(), symbols[i]) - sorted.begin());
+    }
+    symbols = sorted;
+    indexBySymbol.clear();
+    for (int i = 0; i < size(); ++i) indexBySymbol.emplace(symbols[i], i);
+    return remap;
+}
+
+char32_t foldToUpper(char32_t c) {
+    if (c >= 'a' && c <= 'z') return c - 32;
+    if (c < 0x80) return c;
+    if (c >= 0xE0 && c <= 0xFE && c != 0xF7) return c - 32; // Latin-1
+    if (c == 0xFF) return 0x178;
+    if ((c >= 0x100 && c <= 0x137) || (c >= 0x14A && c <= 0x177)) return c & ~char32_t(1); // Latin Extended-A, even upper
+    if ((c >= 0x139 && c <= 0x148) || (c >= 0x179 && c <= 0x17E)) return (c & 1) ? c : c - 1; // odd upper
+    if (c == 0x3C2) return 0x3A3; // final sigma
+    if (c >= 0x3B1 && c <= 0x3C9) return c - 32; // Greek
+    if (c >= 0x430 && c <= 0x44F) return c - 32; // Cyrillic
+    if (c >= 0x450 && c <= 0x45F) return c - 80;
+    return c;
+}
+
+bool isWordLetter(char32_t c) {
+    return (c >= 'A' && c <= 'Z')
+        || (c >= 0xC0 && c <= 0xDF && c != 0xD7)
+        || (c >= 0x100 && c <= 0x17F)
+        || (c >= 0x391 && c <= 0x3A9 && c != 0x3A2)
+        || (c >= 0x400 && c <= 0x42F);
+}
+
+bool decodeUtf8(const char *begin, const char *end, std::u32string& decoded) {
+    decoded.clear();
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(begin);
+    const unsigned char *last = reinterpret_cast<const unsigned char *>(end);
+    while (p < last) {
+        unsigned char lead = *p++;
+        if (lead < 0x80) {
+            decoded.push_back(lead);
+            continue;
+        }
+        int extra = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : -1;
+        if (extra < 0 || last - p < extra) return false;
+        char32_t symbol = lead & (0x3F >> extra);
+        for (int i = 0; i < extra; ++i) {
+            if ((*p & 0xC0) != 0x80) return false;
+            symbol = (symbol << 6) | (*p++ & 0x3F);
+        }
+        decoded.push_back(symbol);
+    }
+    return true;
+}
+
+void appendUtf8(std::string& out, char32_t c) {
+    if (c < 0x80) {
+        out += static_cast<char>(c);
+    } else if (c < 0x800) {
+        out += static_cast<char>(0xC0 | (c >> 6));
+        out += static_cast<char>(0x80 | (c & 0x3F));
+    } else if (c < 0x10000) {
+        out += static_cast<char>(0xE0 | (c >> 12));
+        out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (c & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (c >> 18));
+        out += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (c & 0x3F));
+    }
+}
+
+// ============================================================================
+// Candidate sets
+// ============================================================================
+
+CandidateSet CandidateSet::range(int universe, int begin, int end) {
+    CandidateSet set(universe);
+    for (int i = begin; i < end; ++i) set.insert(i);
+    return set;
+}
+
+CandidateSet CandidateSet::fromList(int universe, std::span<const int> list) {
+    CandidateSet set(universe);
+    for (int index : list) set.insert(index);
+    return set;
+}
+
+int CandidateSet::count() const {
+    int total = 0;
+    for (uint64_t block : blocks) total += std::popcount(block);
+    return total;
+}
+
+bool CandidateSet::empty() const {
+    for (uint64_t block : blocks) {
+        if (block) return false;
+    }
+    return true;
+}
+
+int CandidateSet::first() const {
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        if (blocks[b]) return static_cast<int>(b * 64 + std::countr_zero(blocks[b]));
+    }
+    return -1;
+}
+
+CandidateSet& CandidateSet::operator&=(const CandidateSet& other) {
+    for (size_t b = 0; b < blocks.size(); ++b) blocks[b] &= other.blocks[b];
+    return *this;
+}
+
+CandidateSet& CandidateSet::operator|=(const CandidateSet& other) {
+    for (size_t b = 0; b < blocks.size(); ++b) blocks[b] |= other.blocks[b];
+    return *this;
+}
+
+CandidateSet& CandidateSet::andNot(const CandidateSet& other) {
+    for (size_t b = 0; b < blocks.size(); ++b) blocks[b] &= ~other.blocks[b];
+    return *this;
+}
+
+CandidateList CandidateSet::toList() const {
+    CandidateList list;
+    list.reserve(count());
+    forEach([&list](int index) { list.push_back(index); });
+    return list;
+}
+
+uint64_t CandidateSet::hash() const {
+    // FNV-1a over the blocks
+    uint64_t hash = 1469598103934665603ull;
+    for (uint64_t block : blocks) {
+        hash ^= block;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// ============================================================================
+// Dictionary
+// ============================================================================
+
+int SolverDictionary::indexOf(const std::string& word) const {
+    auto it = indexByWord.find(word);
+    return it == indexByWord.end() ? -1 : it->second;
+}
+
+CandidateSet SolverDictionary::allAnswers() const {
+    return CandidateSet::range(size(), 0, answerCount);
+}
+
+CandidateSet SolverDictionary::allAccepted() const {
+    return CandidateSet::range(size(), answerCount, size());
+}
+
+SolverDictionary buildSolverDictionary(const std::vector<std::string>& answers, const std::vector<std::string>& accepted) {
+    // Collect the alphabet first so indices come out in canonical order
+    SolverDictionary dict;
+    std::vector<std::u32string> decodedAnswers, decodedAccepted;
+    auto decodeAll = [&dict](const std::vector<std::string>& words, std::vector<std::u32string>& decoded) {
+        std::u32string symbols;
+        for (const std::string& word : words) {
+            if (!decodeUtf8(word.data(), word.data() + word.size(), symbols) || symbols.size() != WORD_LENGTH) continue;
+            bool valid = true;
+            for (char32_t& c : symbols) {
+                c = foldToUpper(c);
+                valid = valid && isWordLetter(c) && dict.alphabet.add(c) >= 0;
+            }
+            if (valid) decoded.push_back(symbols);
+        }
+    };
+    decodeAll(answers, decodedAnswers);
+    decodeAll(accepted, decodedAccepted);
+    dict.alphabet.sortSymbols();
+
+    auto addWord = [&dict](const std::u32string& symbols) {
+        std::string word;
+        PackedWord packed;
+        for (int i = 0; i < WORD_LENGTH; ++i) {
+            appendUtf8(word, symbols[i]);
+            packed[i] = static_cast<uint8_t>(dict.alphabet.indexOf(symbols[i]));
+        }
+        if (dict.indexByWord.count(word)) return;
+        dict.indexByWord.emplace(word, dict.size());
+        dict.words.push_back(word);
+        dict.packed.push_back(packed);
+    };
+    for (const std::u32string& word : decodedAnswers) addWord(word);
+    dict.answerCount = dict.size();
+    for (const std::u32string& word : decodedAccepted) addWord(word);
+    return dict;
+}
+
+// ============================================================================
+// Feedback kernel
+// ============================================================================
+
+static const int PATTERN_WEIGHTS[WORD_LENGTH] = {1, 3, 9, 27, 81};
+
+uint8_t computeFeedback(const PackedWord& guess, const PackedWord& answer) {
+    // Greens first, then yellows consume the unmatched answer letters left to right
+    uint8_t unmatched[MAX_ALPHABET_SIZE] = {};
+    int pattern = 0;
+    for (int i = 0; i < WORD_LENGTH; ++i) {
+        if (guess[i] == answer[i]) {
+            pattern += 2 * PATTERN_WEIGHTS[i];
+        } else {
+            unmatched[answer[i]]++;
+        }
+    }
+    for (int i = 0; i < WORD_LENGTH; ++i) {
+        if (guess[i] != answer[i] && unmatched[guess[i]] > 0) {
+            unmatched[guess[i]]--;
+            pattern += PATTERN_WEIGHTS[i];
+        }
+    }
+    return static_cast<uint8_t>(pattern);
+}
+
+std::string patternToString(uint8_t pattern) {
+    std::string feedback(WORD_LENGTH, 'X');
+    for (int i = 0; i < WORD_LENGTH; ++i) {
+        int digit = pattern % 3;
+        pattern /= 3;
+        if (digit == 2) feedback[i] = 'G';
+        else if (digit == 1) feedback[i] = 'Y';
+    }
+    return feedback;
+}
+
+int patternFromString(const std::string& feedback) {
+    if (feedback.size() != WORD_LENGTH) return -1;
+    int pattern = 0;
+    for (int i = 0; i < WORD_LENGTH; ++i) {
+        char c = feedback[i];
+        if (c == 'G') pattern += 2 * PATTERN_WEIGHTS[i];
+        else if (c == 'Y') pattern += PATTERN_WEIGHTS[i];
+        else if (c != 'X') return -1;
+    }
+    return pattern;
+}
+
+static constexpr int FEEDBACK_CHUNK = 256;
+
+// consume(candidate, pattern) for every candidate forEachCandidate(visit) visits, in
+// order. Letters are gathered a chunk at a time for the vector kernel.
+template <typename ForEachCandidate, typename Consume>
+static void forEachFeedback(const SolverDictionary& dict, int guess, const ForEachCandidate& forEachCandidate, const Consume& consume) {
+    uint8_t letters[WORD_LENGTH][FEEDBACK_CHUNK];
+    const uint8_t *planes[WORD_LENGTH];
+    for (int i = 0; i < WORD_LENGTH; ++i) planes[i] = letters[i];
+    int chunk[FEEDBACK_CHUNK];
+    uint8_t patterns[FEEDBACK_CHUNK];
+    int filled = 0;
+    auto flush = [&] {
+        feedbackRow(dict.packed[guess], planes, filled, patterns);
+        for (int c = 0; c < filled; ++c) consume(chunk[c], patterns[c]);
+        filled = 0;
+    };
+    forEachCandidate([&](int candidate) {
+        for (int i = 0; i < WORD_LENGTH; ++i) letters[i][filled] = dict.packed[candidate][i];
+        chunk[filled] = candidate;
+        if (++filled == FEEDBACK_CHUNK) flush();
+    });
+    if (filled > 0) flush();
+}
+
+void feedbackHistogram(const SolverDictionary& dict, int guess, std::span<const int> candidates, PatternHistogram& histogram) {
+    histogram.fill(0);
+    auto visitAll = [&](const auto& visit) {
+        for (int candidate : candidates) visit(candidate);
+    };
+    forEachFeedback(dict, guess, visitAll, [&](int, uint8_t pattern) { histogram[pattern]++; });
+}
+
+CandidateSet filterByFeedback(const SolverDictionary& dict, const CandidateSet& candidates, int guess, uint8_t pattern) {
+    CandidateSet remaining(dict.size());
+    auto visitAll = [&](const auto& visit) { candidates.forEach(visit); };
+    forEachFeedback(dict, guess, visitAll, [&](int candidate, uint8_t candidatePattern) {
+        if (candidatePattern == pattern) remaining.insert(candidate);
+    });
+    return remaining;
+}
+
+bool patternMaskFromString(const std::string& feedback, PatternMask& mask) {
+    if (feedback.size() != WORD_LENGTH) return false;
+    // Start from the one pattern with every unknown tile gray, then fan out per unknown
+    std::vector<int> patterns = {0};
+    for (int i = 0; i < WORD_LENGTH; ++i) {
+        char c = feedback[i];
+        if (c == 'G' || c == 'Y') {
+            for (int& pattern : patterns) pattern += (c == 'G' ? 2 : 1) * PATTERN_WEIGHTS[i];
+        } else if (c == '?') {
+            size_t known = patterns.size();
+            for (int digit = 1; digit <= 2; ++digit) {
+                for (size_t p = 0; p < known; ++p) patterns.push_back(patterns[p] + digit * PATTERN_WEIGHTS[i]);
+            }
+        } else if (c != 'X') {
+            return false;
+        }
+    }
+    mask.reset();
+    for (int pattern : patterns) mask.set(pattern);
+    return true;
+}
+
+CandidateSet filterByPatterns(const SolverDictionary& dict, const CandidateSet& candidates, int guess, const PatternMask& allowed) {
+    if (allowed.all()) return candidates;
+    CandidateSet remaining(dict.size());
+    auto visitAll = [&](const auto& visit) { candidates.forEach(visit); };
+    forEachFeedback(dict, guess, visitAll, [&](int candidate, uint8_t pattern) {
+        if (allowed.test(pattern)) remaining.insert(candidate);
+    });
+    return remaining;
+}
+
+// ============================================================================
+// Constraints
+// ============================================================================
+
+bool SolverConstraints::isEmpty() const {
+    for (int i = 0; i < WORD_LENGTH; ++i) {
+        if (green[i] >= 0 || yellowForbidden[i]) return false;
+    }
+    return !yellowLetters && !grayLetters;
+}
+
+bool matchesConstraints(const PackedWord& word, const SolverConstraints& constraints) {
+    // The legacy gray rule only lets a gray letter sit on a green square of the same
+    // letter, so every check collapses to one allowed-letter test per position
+    for (int i = 0; i < WORD_LENGTH; ++i) {
+        LetterMask bit = LetterMask(1) << word[i];
+        if (constraints.green[i] >= 0) {
+            if (word[i] != constraints.green[i]) return false;
+        } else if (bit & (constraints.grayLetters | constraints.yellowForbidden[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static LetterMask letterMask(const PackedWord& word) {
+    LetterMask mask = 0;
+    for (uint8_t letter : word) mask |= LetterMask(1) << letter;
+    return mask;
+}
+
+CandidateSet possibleAnswers(const SolverDictionary& dict, const SolverConstraints& constraints) {
+    CandidateSet candidates(dict.size());
+    for (int i = 0; i < dict.answerCount; ++i) {
+        const PackedWord& word = dict.packed[i];
+        if ((letterMask(word) & constraints.yellowLetters) != constraints.yellowLetters) continue;
+        if (matchesConstraints(word, constraints)) candidates.insert(i);
+    }
+    return candidates;
+}
+
+CandidateList FeedbackPartition::bucket(int pattern) const {
+    std::span<const int> view = bucketView(pattern);
+    return CandidateList(view.begin(), view.end());
+}
+
+void partitionByFeedback(const SolverDictionary& dict, int guess, std::span<const int> candidates, FeedbackPartition& partition) {
+    // Scratch comes from wherever the partition lives
+    std::pmr::vector<uint8_t> patterns(candidates.size(), partition.members.get_allocator().resource());
+    PatternHistogram histogram{};
+    size_t next = 0;
+    auto visitAll = [&](const auto& visit) {
+        for (int candidate : candidates) visit(candidate);
+    };
+    forEachFeedback(dict, guess, visitAll, [&](int, uint8_t pattern) {
+        patterns[next++] = pattern;
+        histogram[pattern]++;
+    });
+    partition.offsets[0] = 0;
+    for (int p = 0; p < PATTERN_COUNT; ++p) {
+        partition.offsets[p + 1] = partition.offsets[p] + histogram[p];
+    }
+    // Stable scatter keeps each bucket in dictionary order
+    std::array<int, PATTERN_COUNT> cursor;
+    std::copy(partition.offsets.begin(), partition.offsets.end() - 1, cursor.begin());
+    partition.members.resize(candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        partition.members[cursor[patterns[i]]++] = candidates[i];
+    }
+}
+
+// ============================================================================
+// Ranking
+// ============================================================================
+
+static const std::pair<RankingMode, const char *> RANKING_MODE_NAMES[] = {
+    {RankingMode::Heuristic, "heuristic"},
+    {RankingMode::Entropy, "entropy"},
+    {RankingMode::Minimax, "minimax"},
+    {RankingMode::ExpectedSize, "expected-size"},
+    {RankingMode::Lookahead, "lookahead"},
+};
+
+const char *rankingModeName(RankingMode mode) {
+    for (const auto& [named, name] : RANKING_MODE_NAMES) {
+        if (named == mode) return name;
+    }
+    return "";
+}
+
+bool rankingModeFromName(const std::string& name, RankingMode& mode) {
+    for (const auto& [named, modeName] : RANKING_MODE_NAMES) {
+        if (name == modeName) {
+            mode = named;
+            return true;
+        }
+    }
+    return false;
+}
+
+GuessMetrics metricsFromHistogram(int guess, const PatternHistogram& histogram, int total) {
+    GuessMetrics metrics;
+    metrics.guess = guess;
+    metrics.isCandidate = histogram[ALL_GREEN_PATTERN] > 0;
+    if (total <= 0) return metrics;
+    double sumSquares = 0.0;
+    double sumNLogN = 0.0;
+    for (int count : histogram) {
+        if (count == 0) continue;
+        metrics.worstBucket = std::max(metrics.worstBucket, count);
+        sumSquares += static_cast<double>(count) * count;
+        sumNLogN += count * std::log2(static_cast<double>(count));
+    }
+    metrics.entropy = std::log2(static_cast<double>(total)) - sumNLogN / total;
+    metrics.expectedSize = sumSquares / total;
+    return metrics;
+}
+
+bool rankedBefore(const GuessMetrics& a, const GuessMetrics& b, RankingMode mode) {
+    switch (mode) {
+    case RankingMode::Entropy:
+        if (a.entropy != b.entropy) return a.entropy > b.entropy;
+        break;
+    case RankingMode::Minimax:
+        if (a.worstBucket != b.worstBucket) return a.worstBucket < b.worstBucket;
+        if (a.expectedSize != b.expectedSize) return a.expectedSize < b.expectedSize;
+        break;
+    case RankingMode::ExpectedSize:
+    case RankingMode::Heuristic:
+        if (a.expectedSize != b.expectedSize) return a.expectedSize < b.expectedSize;
+        break;
+    case RankingMode::Lookahead:
+        // Guesses without a lookahead score fall back to entropy order
+        if (a.lookaheadSize != b.lookaheadSize) return a.lookaheadSize < b.lookaheadSize;
+        if (a.entropy != b.entropy) return a.entropy > b.entropy;
+        break;
+    }
+    // Prefer guesses that could still win outright
+    if (a.isCandidate != b.isCandidate) return a.isCandidate;
+    return a.guess < b.guess;
+}
+
+// Lookahead scores are sums of squared sub-bucket sizes: a bucket B split by a second
+// guess into B_q leaves sum |B_q|^2 / |B| candidates on average, weighted by |B| / n.
+// A bucket can never do better than all singletons, sum |B_q|^2 = |B|.
+
+// Smallest sum of squares any second guess achieves on bucket
+static int bestSecondGuessSquares(const SolverDictionary& dict, std::span<const int> bucket) {
+    int size = static_cast<int>(bucket.size());
+    if (size <= 2) return size; // guessing either word splits a pair
+    int best = size * size;
+    PatternHistogram histogram{};
+    uint8_t patterns[PATTERN_COUNT];
+    LetterMask present = 0;
+    for (int member : bucket) present |= letterMask(dict.packed[member]);
+    auto consider = [&](int guess) {
+        // A guess sharing no letter with the bucket leaves it whole: size^2, never better
+        const PackedWord& guessWord = dict.packed[guess];
+        if ((letterMask(guessWord) & present) == 0) return false;
+        // (c + 1)^2 - c^2 = 2c + 1, so squares only grow and a guess can be
+        // dropped as soon as it reaches the best so far
+        int squares = 0;
+        int seen = 0;
+        while (seen < size && squares < best) {
+            uint8_t pattern = computeFeedback(guessWord, dict.packed[bucket[seen]]);
+            squares += 2 * histogram[pattern] + 1;
+            histogram[pattern]++;
+            // Buckets past 243 words repeat patterns, so only the first 243 need undoing
+            if (seen < PATTERN_COUNT) patterns[seen] = pattern;
+            ++seen;
+        }
+        if (seen > PATTERN_COUNT) {
+            histogram.fill(0);
+        } else {
+            for (int i = 0; i < seen; ++i) histogram[patterns[i]] = 0;
+        }
+        if (seen == size && squares < best) best = squares;
+        return best == size;
+    };
+    // Members first: they often split perfectly and are cheap to find
+    for (int guess : bucket) {
+        if (consider(guess)) return best;
+    }
+    for (int guess = 0; guess < dict.size(); ++guess) {
+        if (consider(guess)) return best;
+    }
+    return best;
+}
+
+// Per-request memo of bestSecondGuessSquares; the same bucket turns up under
+// many first guesses
+class LookaheadMemo {
+public:
+    bool lookup(std::span<const int> bucket, uint64_t key, int& squares) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        if (it == entries.end() || !std::equal(bucket.begin(), bucket.end(), it->second.first.begin(), it->second.first.end())) return false;
+        squares = it->second.second;
+        return true;
+    }
+
+    void store(std::span<const int> bucket, uint64_t key, int squares) {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries[key] = {CandidateList(bucket.begin(), bucket.end()), squares};
+    }
+
+    static uint64_t keyFor(std::span<const int> bucket) {
+        // FNV-1a over the members, which partitions keep in dictionary order
+        uint64_t hash = 1469598103934665603ull;
+        for (int member : bucket) {
+            hash ^= static_cast<uint32_t>(member);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<uint64_t, std::pair<CandidateList, int>> entries;
+};
+
+// Total squares after guess and the best follow-up in every bucket. Stops once the
+// total can no longer come in under cutoff and returns the bound reached instead.
+static long long lookaheadSquares(const SolverDictionary& dict, std::span<const int> candidates, int guess, long long cutoff, LookaheadMemo& memo, bool& bounded) {
+    ArenaScope scope;
+    FeedbackPartition partition(scope.resource());
+    partitionByFeedback(dict, guess, candidates, partition);
+    std::pmr::vector<int> patterns(scope.resource());
+    for (int p = 0; p < PATTERN_COUNT; ++p) {
+        if (partition.bucketSize(p) > 0) patterns.push_back(p);
+    }
+    // Largest buckets first so the bound tightens fastest
+    std::sort(patterns.begin(), patterns.end(), [&partition](int a, int b) {
+        return partition.bucketSize(a) > partition.bucketSize(b);
+    });
+    long long total = 0;
+    long long lowerRest = static_cast<long long>(candidates.size());
+    bounded = false;
+    for (int pattern : patterns) {
+        std::span<const int> bucket = partition.bucketView(pattern);
+        lowerRest -= static_cast<long long>(bucket.size());
+        int squares;
+        if (bucket.size() <= 2) {
+            squares = static_cast<int>(bucket.size());
+        } else {
+            uint64_t key = LookaheadMemo::keyFor(bucket);
+            if (!memo.lookup(bucket, key, squares)) {
+                squares = bestSecondGuessSquares(dict, bucket);
+                memo.store(bucket, key, squares);
+            }
+        }
+        total += squares;
+        if (total + lowerRest > cutoff) {
+            bounded = true;
+            return total + lowerRest;
+        }
+    }
+    return total;
+}
+
+// Fills lookaheadSize for head (the entropy leaders). Only the best firstPage scores
+// need to be exact, so the firstPage-th best total so far prunes the rest.
+static void applyLookahead(const SolverDictionary& dict, std::span<const int> candidates, std::vector<GuessMetrics>& head, int firstPage, bool parallel) {
+    if (candidates.empty()) return;
+    LookaheadMemo memo;
+    // The firstPage best exact totals; once there are that many, the worst of them is
+    // the cutoff, republished on each insert so workers read it without the lock
+    std::mutex bestMutex;
+    BoundedTopK<long long, std::less<long long>> bestTotals(std::max(1, firstPage), std::less<long long>());
+    std::atomic<long long> cutoff{std::numeric_limits<long long>::max()};
+    double n = static_cast<double>(candidates.size());
+    auto evaluateRange = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            bool bounded = false;
+            long long total = lookaheadSquares(dict, candidates, head[i].guess, cutoff.load(std::memory_order_relaxed), memo, bounded);
+            head[i].lookaheadSize = total / n;
+            head[i].lookaheadBound = bounded;
+            if (!bounded) {
+                std::lock_guard<std::mutex> lock(bestMutex);
+                bestTotals.push(total);
+                if (bestTotals.full()) cutoff.store(bestTotals.worst(), std::memory_order_relaxed);
+            }
+        }
+    };
+    if (parallel) {
+        parallelFor(static_cast<int>(head.size()), evaluateRange);
+    } else {
+        evaluateRange(0, static_cast<int>(head.size()));
+    }
+}
+
+// metricsFromHistogram for one row of patterns. histogram must start zeroed and is left
+// zeroed; up to PATTERN_COUNT candidates only the row's own buckets are visited, in
+// order of first appearance, so rows splitting alike give bit-identical metrics.
+static GuessMetrics metricsFromRow(int guess, const uint8_t *row, int total, PatternHistogram& histogram) {
+    for (int c = 0; c < total; ++c) histogram[row[c]]++;
+    if (total > PATTERN_COUNT) {
+        GuessMetrics metrics = metricsFromHistogram(guess, histogram, total);
+        histogram.fill(0);
+        return metrics;
+    }
+    GuessMetrics metrics;
+    metrics.guess = guess;
+    metrics.isCandidate = histogram[ALL_GREEN_PATTERN] > 0;
+    if (total <= 0) return metrics;
+    double sumSquares = 0.0;
+    double sumNLogN = 0.0;
+    for (int c = 0; c < total; ++c) {
+        int count = histogram[row[c]];
+        if (count == 0) continue; // bucket already counted
+        histogram[row[c]] = 0;
+        metrics.worstBucket = std::max(metrics.worstBucket, count);
+        sumSquares += static_cast<double>(count) * count;
+        sumNLogN += count * std::log2(static_cast<double>(count));
+    }
+    metrics.entropy = std::log2(static_cast<double>(total)) - sumNLogN / total;
+    metrics.expectedSize = sumSquares / total;
+    return metrics;
+}
+
+// Open-addressed map from a 64-bit key to the first value stored under it, sized
+// up front for a scan so lookups never allocate
+class FirstSeenTable {
+public:
+    explicit FirstSeenTable(int capacity) : slots(std::bit_ceil(static_cast<size_t>(capacity) * 2 + 2)), mask(slots.size() - 1) {}
+
+    // The value stored under key for which same(value) holds; otherwise stores value
+    // and returns -1
+    template <typename Same>
+    int findOrAdd(uint64_t key, int value, const Same& same) {
+        for (size_t i = (key * 0x9E3779B97F4A7C15ull) >> 32 & mask;; i = (i + 1) & mask) {
+            if (slots[i].value < 0) {
+                slots[i] = {key, value};
+                return -1;
+            }
+            if (slots[i].key == key && same(slots[i].value)) return slots[i].value;
+        }
+    }
+
+private:
+    struct Slot {
+        uint64_t key = 0;
+        int value = -1;
+    };
+    std::vector<Slot> slots;
+    size_t mask;
+};
+
+// Candidates up to which equivalent guesses are detected by partition signature;
+// past it nearly every guess splits the candidates its own way
+static constexpr int SIGNATURE_LIMIT = 32;
+
+// Scans every guess in bands of bandRows, then orders the head. rowOf(guess, buffer)
+// returns the guess's pattern against each candidate, in candidate order, either
+// computed into buffer or pointing into a pattern matrix. Letters no candidate
+// contains are gray wherever they stand and take no yellow from another letter, so
+// guesses that agree once those are blanked out get the same row, and only the first
+// is scanned (a guess of nothing but such letters is one all-gray partition). On small
+// candidate sets a row that splits the candidates into the same groups as one already
+// scored, with the same winning candidate, copies its metrics as well.
+template <typename RowOf>
+static GuessRanking rankFromPatterns(const SolverDictionary& dict, std::span<const int> candidates, RankingMode mode, int firstPage,
+                                     bool parallel, int bandRows, const RowOf& rowOf) {
+    GuessOrder order{mode};
+    // Lookahead needs the entropy leaders from the scan, then re-orders them
+    bool lookahead = mode == RankingMode::Lookahead;
+    GuessOrder scanOrder{lookahead ? RankingMode::Entropy : mode};
+    int headSize = lookahead ? std::max(firstPage, LOOKAHEAD_WIDTH) : firstPage;
+    std::vector<GuessMetrics> metrics(dict.size());
+    BoundedTopK<GuessMetrics, GuessOrder> best(headSize, scanOrder);
+    std::mutex bestMutex;
+    int total = static_cast<int>(candidates.size());
+    LetterMask present = 0;
+    for (int candidate : candidates) present |= letterMask(dict.packed[candidate]);
+    bool deduplicate = total <= SIGNATURE_LIMIT;
+    int bands = (dict.size() + bandRows - 1) / bandRows;
+    auto scoreBands = [&](int beginBand, int endBand) {
+        int firstRow = beginBand * bandRows;
+        int endRow = std::min(dict.size(), endBand * bandRows);
+        PatternHistogram histogram{};
+        std::vector<uint8_t> buffer(total);
+        std::array<uint8_t, PATTERN_COUNT> label;
+        label.fill(0xFF);
+        std::vector<uint8_t> signature(deduplicate ? total : 0);
+        FirstSeenTable projected(endRow - firstRow);                  // blanked guess -> guess
+        FirstSeenTable partitions(deduplicate ? endRow - firstRow : 0); // signature hash -> index below
+        std::vector<uint8_t> signatures;                               // each distinct signature, back to back
+        std::vector<int> signatureGuess;
+        BoundedTopK<GuessMetrics, GuessOrder> local(headSize, scanOrder);
+        for (int g = firstRow; g < endRow; ++g) {
+            GuessMetrics& m = metrics[g];
+            uint64_t projection = 0;
+            for (uint8_t letter : dict.packed[g]) {
+                projection = projection * (MAX_ALPHABET_SIZE + 1) + ((present >> letter) & 1 ? letter : MAX_ALPHABET_SIZE);
+            }
+            int same = projected.findOrAdd(projection, g, [](int) { return true; });
+            if (same < 0 && deduplicate) {
+                const uint8_t *row = rowOf(g, buffer.data());
+                // Groups numbered by first appearance; the all-green group keeps its own label
+                uint8_t next = 0;
+                uint64_t hash = 1469598103934665603ull;
+                for (int c = 0; c < total; ++c) {
+                    uint8_t& l = label[row[c]];
+                    if (l == 0xFF) l = row[c] == ALL_GREEN_PATTERN ? 0xFE : next++;
+                    signature[c] = l;
+                    hash = (hash ^ l) * 1099511628211ull;
+                }
+                for (int c = 0; c < total; ++c) label[row[c]] = 0xFF;
+                int index = partitions.findOrAdd(hash, static_cast<int>(signatureGuess.size()), [&](int other) {
+                    return std::equal(signature.begin(), signature.end(), signatures.begin() + static_cast<size_t>(other) * total);
+                });
+                if (index >= 0) {
+                    same = signatureGuess[index];
+                } else {
+                    signatures.insert(signatures.end(), signature.begin(), signature.end());
+                    signatureGuess.push_back(g);
+                    m = metricsFromRow(g, row, total, histogram);
+                }
+            } else if (same < 0) {
+                m = metricsFromRow(g, rowOf(g, buffer.data()), total, histogram);
+            }
+            if (same >= 0) {
+                m = metrics[same];
+                m.guess = g;
+            }
+            local.push(m);
+        }
+        std::lock_guard<std::mutex> lock(bestMutex);
+        best.merge(local);
+    };
+    if (parallel) {
+        parallelFor(bands, scoreBands);
+    } else {
+        scoreBands(0, bands);
+    }
+
+    // Sorted head first, everything else after it in dictionary order
+    std::vector<GuessMetrics> head = best.sorted();
+    if (lookahead) {
+        applyLookahead(dict, candidates, head, firstPage, parallel);
+        std::sort(head.begin(), head.end(), order);
+    }
+    std::vector<bool> inHead(metrics.size(), false);
+    for (const GuessMetrics& m : head) inHead[m.guess] = true;
+    std::vector<GuessMetrics> items = head;
+    items.reserve(metrics.size());
+    for (const GuessMetrics& m : metrics) {
+        if (!inHead[m.guess]) items.push_back(m);
+    }
+    return GuessRanking(std::move(items), order, static_cast<int>(head.size()));
+}
+
+GuessRanking rankGuesses(const SolverDictionary& dict, std::span<const int> candidates, RankingMode mode, int firstPage, bool parallel) {
+    LetterPlanes planes = LetterPlanes::gather(dict, candidates);
+    return rankFromPatterns(dict, candidates, mode, firstPage, parallel, 1, [&](int guess, uint8_t *buffer) {
+        planes.row(dict.packed[guess], buffer);
+        return static_cast<const uint8_t *>(buffer);
+    });
+}
+
+// ============================================================================
+// Pattern matrix
+// ============================================================================
+
+static constexpr size_t PATTERN_BAND_BYTES = 256 * 1024; // a band of rows per L2
+
+bool PatternMatrix::fits(const SolverDictionary& dict) {
+    return static_cast<size_t>(dict.size()) * static_cast<size_t>(dict.answerCount) <= MAX_BYTES;
+}
+
+PatternMatrix PatternMatrix::build(const SolverDictionary& dict) {
+    PatternMatrix matrix;
+    matrix.rows = dict.size();
+    matrix.columnBits = dict.allAnswers();
+    matrix.columnList = matrix.columnBits.toList();
+    size_t width = matrix.columnList.size();
+    matrix.patterns.resize(static_cast<size_t>(matrix.rows) * width);
+    LetterPlanes planes = LetterPlanes::gather(dict, matrix.columnList);
+    parallelFor(matrix.rows, [&](int begin, int end) {
+        for (int guess = begin; guess < end; ++guess) planes.row(dict.packed[guess], matrix.patterns.data() + static_cast<size_t>(guess) * width);
+    });
+    return matrix;
+}
+
+bool PatternMatrix::covers(const CandidateSet& candidates) const {
+    return candidates.universe() == columnBits.universe() && (candidates & columnBits) == candidates;
+}
+
+PatternMatrix PatternMatrix::compact(const CandidateSet& candidates) const {
+    PatternMatrix narrow;
+    narrow.rows = rows;
+    narrow.columnBits = candidates;
+    std::vector<int> kept; // source column of each new column
+    for (size_t c = 0; c < columnList.size(); ++c) {
+        if (candidates.contains(columnList[c])) {
+            kept.push_back(static_cast<int>(c));
+            narrow.columnList.push_back(columnList[c]);
+        }
+    }
+    size_t width = columnList.size();
+    narrow.patterns.resize(static_cast<size_t>(rows) * kept.size());
+    parallelFor(rows, [&](int begin, int end) {
+        for (int guess = begin; guess < end; ++guess) {
+            const uint8_t *in = patterns.data() + static_cast<size_t>(guess) * width;
+            uint8_t *out = narrow.patterns.data() + static_cast<size_t>(guess) * kept.size();
+            for (size_t c = 0; c < kept.size(); ++c) out[c] = in[kept[c]];
+        }
+    });
+    return narrow;
+}
+
+GuessRanking rankGuesses(const SolverDictionary& dict, const PatternMatrix& patterns, RankingMode mode, int firstPage, bool parallel) {
+    size_t width = patterns.columns().size();
+    int bandRows = static_cast<int>(std::max<size_t>(1, PATTERN_BAND_BYTES / std::max<size_t>(1, width)));
+    return rankFromPatterns(dict, patterns.columns(), mode, firstPage, parallel, bandRows, [&](int guess, uint8_t *) {
+        return patterns.row(guess);
+    });
+}
+
+// ============================================================================
+// Sampled ranking
+// ============================================================================
+
+// size candidates spread over first letters in proportion, evenly spaced within each
+static CandidateList stratifiedSample(const SolverDictionary& dict, std::span<const int> candidates, int size) {
+    std::vector<CandidateList> strata(MAX_ALPHABET_SIZE);
+    for (int candidate : candidates) strata[dict.packed[candidate][0]].push_back(candidate);
+    std::array<int, MAX_ALPHABET_SIZE> seats{};
+    std::vector<std::pair<double, int>> remainders; // seat fraction rounding dropped, letter
+    int given = 0;
+    for (int letter = 0; letter < MAX_ALPHABET_SIZE; ++letter) {
+        double exact = static_cast<double>(size) * strata[letter].size() / candidates.size();
+        seats[letter] = static_cast<int>(exact);
+        given += seats[letter];
+        remainders.push_back({exact - seats[letter], letter});
+    }
+    // Seats left over by rounding down go to the largest remainders
+    std::stable_sort(remainders.begin(), remainders.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (size_t i = 0; given < size && i < remainders.size(); ++i, ++given) seats[remainders[i].second]++;
+
+    CandidateList sample;
+    sample.reserve(size);
+    for (int letter = 0; letter < MAX_ALPHABET_SIZE; ++letter) {
+        size_t members = strata[letter].size();
+        for (int k = 0; k < seats[letter]; ++k) sample.push_back(strata[letter][(2 * k + 1) * members / (2 * seats[letter])]);
+    }
+    std::sort(sample.begin(), sample.end());
+    return sample;
+}
+
+struct SampledScore {
+    GuessMetrics metrics; // expectedSize and worstBucket scaled up to every candidate
+    double score = 0.0;   // the mode's metric, larger is better
+    double error = 0.0;   // its standard error from the sample
+};
+
+// Sample histogram -> estimate over total candidates. The error treats each sampled
+// candidate as one draw of the metric's per-candidate term (-log2 of its bucket share
+// for entropy, its bucket share for expected size) or, for minimax, the largest
+// bucket's share as a proportion.
+static SampledScore sampledScore(int guess, const PatternHistogram& histogram, int sample, int total, RankingMode mode) {
+    SampledScore estimate;
+    GuessMetrics& metrics = estimate.metrics;
+    metrics = metricsFromHistogram(guess, histogram, sample);
+    double n = static_cast<double>(sample);
+    double scale = total / n;
+    metrics.expectedSize *= scale;
+    metrics.worstBucket = static_cast<int>(std::lround(metrics.worstBucket * scale));
+    double variance = 0.0;
+    if (mode == RankingMode::Minimax) {
+        double share = *std::max_element(histogram.begin(), histogram.end()) / n;
+        estimate.score = -share * total;
+        estimate.error = std::sqrt(share * (1.0 - share) / n) * total;
+    } else if (mode == RankingMode::ExpectedSize) {
+        double mean = metrics.expectedSize / total;
+        for (int count : histogram) {
+            if (count > 0) variance += count * std::pow(count / n - mean, 2) / n;
+        }
+        estimate.score = -metrics.expectedSize;
+        estimate.error = std::sqrt(variance / n) * total;
+    } else {
+        for (int count : histogram) {
+            if (count > 0) variance += count * std::pow(-std::log2(count / n) - metrics.entropy, 2) / n;
+        }
+        estimate.score = metrics.entropy;
+        estimate.error = std::sqrt(variance / n);
+    }
+    return estimate;
+}
+
+GuessRanking rankGuessesSampled(const SolverDictionary& dict, std::span<const int> candidates, RankingMode mode, int firstPage,
+                                const SampledRankingOptions& options, SampledRankingReport& report, bool parallel) {
+    report = SampledRankingReport();
+    auto forRange = [&](int count, const std::function<void(int, int)>& body) {
+        if (parallel) {
+            parallelFor(count, body);
+        } else {
+            body(0, count);
+        }
+    };
+    // Lookahead is too costly to sample; rounds keep the entropy leaders it starts from
+    bool lookahead = mode == RankingMode::Lookahead;
+    GuessOrder roundOrder{lookahead ? RankingMode::Entropy : mode};
+    int total = static_cast<int>(candidates.size());
+    int keepFactor = std::max(2, options.keepFactor);
+    size_t minSurvivors = static_cast<size_t>(std::max({options.minSurvivors, 4 * firstPage, LOOKAHEAD_WIDTH, 1}));
+    int referenceRank = std::max(1, firstPage);
+
+    CandidateList survivors(dict.size());
+    for (int guess = 0; guess < dict.size(); ++guess) survivors[guess] = guess;
+    std::vector<std::vector<GuessMetrics>> dropped; // by round, best first
+    double risk = 0.0;
+    for (long long sampleSize = std::max(1, options.initialSample); sampleSize * 2 <= total && survivors.size() > minSurvivors;
+         sampleSize *= 2) {
+        CandidateList sample = stratifiedSample(dict, candidates, static_cast<int>(sampleSize));
+        LetterPlanes planes = LetterPlanes::gather(dict, sample);
+        std::vector<SampledScore> scores(survivors.size());
+        forRange(static_cast<int>(survivors.size()), [&](int begin, int end) {
+            std::vector<uint8_t> row(sample.size());
+            PatternHistogram histogram;
+            for (int i = begin; i < end; ++i) {
+                planes.row(dict.packed[survivors[i]], row.data());
+                histogram.fill(0);
+                for (uint8_t pattern : row) histogram[pattern]++;
+                scores[i] = sampledScore(survivors[i], histogram, static_cast<int>(sample.size()), total, roundOrder.mode);
+            }
+        });
+        std::sort(scores.begin(), scores.end(), [&](const SampledScore& a, const SampledScore& b) { return roundOrder(a.metrics, b.metrics); });
+
+        size_t keep = std::max(minSurvivors, (scores.size() + keepFactor - 1) / keepFactor);
+        const SampledScore& reference = scores[std::min<size_t>(referenceRank, keep) - 1];
+        std::vector<GuessMetrics> out;
+        for (size_t i = keep; i < scores.size(); ++i) {
+            double spread = std::hypot(reference.error, scores[i].error);
+            double gap = reference.score - scores[i].score;
+            risk += spread > 0.0 ? 0.5 * std::erfc(gap / (spread * std::sqrt(2.0))) : (gap < 0.0 ? 1.0 : 0.0);
+            out.push_back(scores[i].metrics);
+        }
+        dropped.push_back(std::move(out));
+        survivors.resize(keep);
+        for (size_t i = 0; i < keep; ++i) survivors[i] = scores[i].metrics.guess;
+        report.pairsScored += static_cast<long long>(scores.size()) * sampleSize;
+        ++report.rounds;
+    }
+
+    // The survivors on every candidate
+    LetterPlanes planes = LetterPlanes::gather(dict, candidates);
+    std::vector<GuessMetrics> exact(survivors.size());
+    forRange(static_cast<int>(survivors.size()), [&](int begin, int end) {
+        std::vector<uint8_t> row(total);
+        PatternHistogram histogram;
+        for (int i = begin; i < end; ++i) {
+            planes.row(dict.packed[survivors[i]], row.data());
+            histogram.fill(0);
+            for (uint8_t pattern : row) histogram[pattern]++;
+            exact[i] = metricsFromHistogram(survivors[i], histogram, total);
+        }
+    });
+    report.pairsScored += static_cast<long long>(survivors.size()) * total;
+    report.exactGuesses = static_cast<int>(survivors.size());
+    report.confidence = std::max(0.0, 1.0 - risk);
+    GuessOrder order{mode};
+    std::sort(exact.begin(), exact.end(), roundOrder);
+    if (lookahead) {
+        std::vector<GuessMetrics> head(exact.begin(), exact.begin() + std::min<size_t>(exact.size(), std::max(firstPage, LOOKAHEAD_WIDTH)));
+        applyLookahead(dict, candidates, head, firstPage, parallel);
+        std::sort(head.begin(), head.end(), order);
+        std::copy(head.begin(), head.end(), exact.begin());
+    }
+
+    std::vector<GuessMetrics> items = std::move(exact);
+    for (auto round = dropped.rbegin(); round != dropped.rend(); ++round) items.insert(items.end(), round->begin(), round->end());
+    int ordered = static_cast<int>(items.size());
+    return GuessRanking(std::move(items), order, ordered);
+}
+
+// ============================================================================
+// Solver cache
+// ============================================================================
+
+uint64_t SolverCache::keyFor(const CandidateSet& candidates, RankingMode mode) {
+    return candidates.hash() * 31 + static_cast<uint64_t>(mode);
+}
+
+bool SolverCache::lookup(const CandidateSet& candidates, RankingMode mode, GuessRanking& ranking) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(keyFor(candidates, mode));
+    if (it == entries.end() || it->second.mode != mode || it->second.candidates != candidates) return false;
+    it->second.lastUse = ++useClock;
+    ranking = it->second.ranking;
+    return true;
+}
+
+bool SolverCache::contains(const CandidateSet& candidates, RankingMode mode) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(keyFor(candidates, mode));
+    return it != entries.end() && it->second.mode == mode && it->second.candidates == candidates;
+}
+
+void SolverCache::store(const CandidateSet& candidates, RankingMode mode, const GuessRanking& ranking) {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t key = keyFor(candidates, mode);
+    // A prewarm and the foreground ranking can store the same position; that replaces it in place
+    if (entries.size() >= capacity && entries.find(key) == entries.end()) {
+        auto oldest = std::min_element(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+            return a.second.lastUse < b.second.lastUse;
+        });
+        entries.erase(oldest);
+    }
+    entries[key] = Entry{candidates, mode, ranking, ++useClock};
+}
+
+void SolverCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+}
+
+void SolverCache::setPatternMatrix(std::shared_ptr<const PatternMatrix> patterns) {
+    std::lock_guard<std::mutex> lock(mutex);
+    fullPatterns = std::move(patterns);
+    narrowPatterns.reset();
+}
+
+std::shared_ptr<const PatternMatrix> SolverCache::patternsFor(const CandidateSet& candidates) {
+    std::shared_ptr<const PatternMatrix> source;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!fullPatterns || !fullPatterns->covers(candidates)) return nullptr;
+        source = narrowPatterns && narrowPatterns->covers(candidates) ? narrowPatterns : fullPatterns;
+    }
+    if (source->columnSet() == candidates) return source;
+    // Copied outside the lock; a racing caller at worst compacts the same columns twice
+    auto narrow = std::make_shared<const PatternMatrix>(source->compact(candidates));
+    std::lock_guard<std::mutex> lock(mutex);
+    narrowPatterns = narrow;
+    return narrow;
+}
+
+GuessRanking cachedRankGuesses(const SolverDictionary& dict, const CandidateSet& candidates, RankingMode mode, int firstPage, SolverCache& cache) {
+    GuessRanking ranking;
+    if (cache.lookup(candidates, mode, ranking)) return ranking;
+    std::shared_ptr<const PatternMatrix> patterns = cache.patternsFor(candidates);
+    if (patterns) {
+        ranking = rankGuesses(dict, *patterns, mode, firstPage);
+    } else if (static_cast<long long>(dict.size()) * candidates.count() > EXACT_RANKING_PAIRS) {
+        SampledRankingReport report;
+        ranking = rankGuessesSampled(dict, candidates.toList(), mode, firstPage, SampledRankingOptions(), report);
+    } else {
+        ranking = rankGuesses(dict, candidates.toList(), mode, firstPage);
+    }
+    cache.store(candidates, mode, ranking);
+    return ranking;
+}
+
+void prewarmFollowUps(const SolverDictionary& dict, const CandidateSet& candidates, int guess, RankingMode mode, int maxBuckets, SolverCache& cache, const std::function<bool()>& cancelled) {
+    ArenaScope scope;
+    FeedbackPartition partition(scope.resource());
+    partitionByFeedback(dict, guess, candidates.toList(), partition);
+    std::vector<int> patterns;
+    for (int p = 0; p < PATTERN_COUNT; ++p) {
+        // Singletons and the win need no follow-up ranking
+        if (p != ALL_GREEN_PATTERN && partition.bucketSize(p) > 1) patterns.push_back(p);
+    }
+    // Under a uniform prior a bucket's probability is its size
+    keepTop(patterns, maxBuckets, [&partition](int a, int b) {
+        return partition.bucketSize(a) > partition.bucketSize(b);
+    });
+    for (int pattern : patterns) {
+        if (cancelled()) return;
+        std::span<const int> bucket = partition.bucketView(pattern);
+        CandidateSet bucketSet = CandidateSet::fromList(dict.size(), bucket);
+        if (cache.contains(bucketSet, mode)) continue;
+        cache.store(bucketSet, mode, rankGuesses(dict, bucket, mode, 10, false));
+    }
+}
+
+std::vector<MoveAnalysis> analyzeGame(const SolverDictionary& dict, std::span<const int> guesses, std::span<const uint8_t> patterns, SolverCache& cache) {
+    std::vector<MoveAnalysis> moves;
+    CandidateSet candidates = dict.allAnswers();
+    for (size_t turn = 0; turn < guesses.size() && turn < patterns.size(); ++turn) {
+        MoveAnalysis move;
+        move.guess = guesses[turn];
+        move.pattern = patterns[turn];
+        move.candidatesBefore = candidates.count();
+        if (move.candidatesBefore == 0) break;
+
+        CandidateList list = candidates.toList();
+        PatternHistogram histogram{};
+        feedbackHistogram(dict, move.guess, list, histogram);
+        move.expectedBits = metricsFromHistogram(move.guess, histogram, move.candidatesBefore).entropy;
+        std::vector<GuessMetrics> best = cachedRankGuesses(dict, candidates, RankingMode::Entropy, 1, cache).page(0, 1);
+        if (!best.empty()) {
+            move.bestGuess = best.front().guess;
+            move.bestExpectedBits = best.front().entropy;
+        }
+
+        candidates = filterByFeedback(dict, candidates, move.guess, move.pattern);
+        move.candidatesAfter = candidates.count();
+        if (move.candidatesAfter > 0) {
+            move.bitsGained = std::log2(static_cast<double>(move.candidatesBefore) / move.candidatesAfter);
+        }
+        moves.push_back(move);
+    }
+    return moves;
+}
+
+// ============================================================================
+// Scratch arena
+// ============================================================================
+
+static std::atomic<size_t> arenaPeakBytes{0};
+static std::atomic<size_t> arenaReservedBytes{0};
+static std::atomic<size_t> arenaUpstreamAllocations{0};
+static std::atomic<size_t> arenaStatsEpoch{0}; // bumped by resetSolverArenaStats
+
+SolverArena& SolverArena::forThread() {
+    thread_local SolverArena arena;
+    return arena;
+}
+
+SolverArena::~SolverArena() {
+    for (const Chunk& chunk : chunks) arenaReservedBytes -= chunk.size;
+}
+
+size_t SolverArena::peakBytes() const {
+    return peakEpoch == arenaStatsEpoch.load(std::memory_order_relaxed) ? peak : inUse;
+}
+
+void SolverArena::release(const Mark& mark) {
+    current = mark.chunk;
+    offset = mark.offset;
+    inUse = mark.inUse;
+}
+
+void *SolverArena::do_allocate(size_t bytes, size_t alignment) {
+    const size_t MIN_CHUNK_BYTES = 256 * 1024;
+    for (;;) {
+        if (current < chunks.size()) {
+            Chunk& chunk = chunks[current];
+            uintptr_t base = reinterpret_cast<uintptr_t>(chunk.data.get());
+            size_t aligned = ((base + offset + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+            if (aligned + bytes <= chunk.size) {
+                size_t epoch = arenaStatsEpoch.load(std::memory_order_relaxed);
+                if (epoch != peakEpoch) {
+                    // Thread-local, so a reset elsewhere is only noticed here
+                    peakEpoch = epoch;
+                    peak = inUse;
+                }
+                inUse += aligned + bytes - offset;
+                offset = aligned + bytes;
+                peak = std::max(peak, inUse);
+                size_t seen = arenaPeakBytes.load(std::memory_order_relaxed);
+                while (inUse > seen && !arenaPeakBytes.compare_exchange_weak(seen, inUse, std::memory_order_relaxed)) {}
+                return chunk.data.get() + aligned;
+            }
+            // The tail of a chunk that cannot fit the request stays unused until a rewind
+            inUse += chunk.size - offset;
+            offset = 0;
+            if (++current < chunks.size()) continue;
+        }
+        // Out of chunks: each new one at least doubles what the arena holds
+        size_t size = std::max({MIN_CHUNK_BYTES, bytes + alignment, chunks.empty() ? size_t(0) : chunks.back().size * 2});
+        chunks.push_back({std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+        current = chunks.size() - 1;
+        offset = 0;
+        arenaReservedBytes += size;
+        ++arenaUpstreamAllocations;
+    }
+}
+
+ArenaStats solverArenaStats() {
+    ArenaStats stats;
+    stats.peakBytes = arenaPeakBytes.load();
+    stats.reservedBytes = arenaReservedBytes.load();
+    stats.upstreamAllocations = arenaUpstreamAllocations.load();
+    return stats;
+}
+
+void resetSolverArenaStats() {
+    arenaPeakBytes = 0;
+    arenaUpstreamAllocations = 0;
+    ++arenaStatsEpoch;
+}
+
+// ============================================================================
+// Parallel helper
+// ============================================================================
+
+namespace {
+
+// One parallelFor call; lives on the caller's stack until every helper has let go
+struct ParallelJob {
+    const std::function<void(int, int)> *body;
+    int count;
+    int grain;
+    std::atomic<int> next{0};
+    int helpers = 0; // guarded by the pool mutex
+
+    // Claims and runs one chunk; false once every chunk is claimed
+    bool runChunk() {
+        int begin = next.fetch_add(grain);
+        if (begin >= count) return false;
+        (*body)(begin, std::min(count, begin + grain));
+        return true;
+    }
+};
+
+class WorkerPool {
+public:
+    static WorkerPool& instance() {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    int threadCount() const { return static_cast<int>(workers.size()) + 1; }
+
+    void run(ParallelJob& job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(&job);
+        }
+        wake.notify_all();
+        while (job.runChunk()) {}
+        std::unique_lock<std::mutex> lock(mutex);
+        auto it = std::find(jobs.begin(), jobs.end(), &job);
+        if (it != jobs.end()) jobs.erase(it);
+        idle.wait(lock, [&job]() { return job.helpers == 0; });
+    }
+
+private:
+    WorkerPool() {
+        // The calling thread always works, so one fewer worker than cores
+        int count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency())) - 1;
+        for (int i = 0; i < count; ++i) workers.emplace_back([this]() { workerLoop(); });
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    void workerLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this]() { return stopping || !jobs.empty(); });
+            if (stopping) return;
+            ParallelJob *job = jobs.front();
+            ++job->helpers;
+            lock.unlock();
+            while (job->runChunk()) {}
+            lock.lock();
+            // Exhausted, stop offering it to the other workers
+            auto it = std::find(jobs.begin(), jobs.end(), job);
+            if (it != jobs.end()) jobs.erase(it);
+            if (--job->helpers == 0) idle.notify_all();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::deque<ParallelJob *> jobs;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+};
+
+} // namespace
+
+void parallelFor(int count, const std::function<void(int begin, int end)>& body) {
+    if (count <= 0) return;
+    WorkerPool& pool = WorkerPool::instance();
+    int threadCount = pool.threadCount();
+    if (threadCount == 1 || count == 1) {
+        body(0, count);
+        return;
+    }
+    // A few chunks per thread so a slow chunk does not leave the others idle
+    ParallelJob job;
+    job.body = &body;
+    job.count = count;
+    job.grain = std::max(1, count / (threadCount * 4));
+    pool.run(job);
+}
+
+// ============================================================================
+// Adversarial engine
+// ============================================================================
+
+static int countDigits(int pattern, int digit) {
+    int count = 0;
+    for (int i = 0; i < WORD_LENGTH; ++i) {
+        if (pattern % 3 == digit) count++;
+        pattern /= 3;
+    }
+    return count;
+}
+
+// Absurdle tie-break: largest bucket, then never concede the win, then fewest greens, then fewest yellows
+static bool adversaryPrefers(int a, int b, const PatternHistogram& histogram) {
+    if (histogram[a] != histogram[b]) return histogram[a] > histogram[b];
+    if ((a == ALL_GREEN_PATTERN) != (b == ALL_GREEN_PATTERN)) return b == ALL_GREEN_PATTERN;
+    int greensA = countDigits(a, 2), greensB = countDigits(b, 2);
+    if (greensA != greensB) return greensA < greensB;
+    int yellowsA = countDigits(a, 1), yellowsB = countDigits(b, 1);
+    if (yellowsA != yellowsB) return yellowsA < yellowsB;
+    return a < b;
+}
+
+// The bucket the adversary keeps; the partition must not be empty
+static int adversaryPattern(const FeedbackPartition& partition) {
+    PatternHistogram histogram;
+    for (int p = 0; p < PATTERN_COUNT; ++p) histogram[p] = partition.bucketSize(p);
+    int chosen = -1;
+    for (int p = 0; p < PATTERN_COUNT; ++p) {
+        if (histogram[p] == 0) continue;
+        if (chosen < 0 || adversaryPrefers(p, chosen, histogram)) chosen = p;
+    }
+    return chosen;
+}
+
+AdversaryResponse adversarialResponse(const SolverDictionary& dict, int guess, const CandidateSet& candidates) {
+    AdversaryResponse response;
+    response.remaining = CandidateSet(dict.size());
+    if (candidates.empty()) return response;
+    ArenaScope scope;
+    FeedbackPartition partition(scope.resource());
+    partitionByFeedback(dict, guess, candidates.toList(), partition);
+    int chosen = adversaryPattern(partition);
+    response.pattern = static_cast<uint8_t>(chosen);
+    response.remaining = CandidateSet::fromList(dict.size(), partition.bucketView(chosen));
+    return response;
+}
+
+struct BucketRank {
+    int guess;
+    int largestBucket;
+    bool isCandidate;
+};
+
+static bool bucketRankLess(const BucketRank& a, const BucketRank& b) {
+    if (a.largestBucket != b.largestBucket) return a.largestBucket < b.largestBucket;
+    if (a.isCandidate != b.isCandidate) return a.isCandidate;
+    return a.guess < b.guess;
+}
+
+static BucketRank rankGuessByLargestBucket(const SolverDictionary& dict, int guess, std::span<const int> candidates, PatternHistogram& histogram) {
+    feedbackHistogram(dict, guess, candidates, histogram);
+    int largest = 0;
+    for (int p = 0; p < PATTERN_COUNT; ++p) {
+        // A lone all-green bucket is a win, the adversary will never choose it
+        if (p == ALL_GREEN_PATTERN && histogram[p] == 1 && static_cast<int>(candidates.size()) > 1) continue;
+        largest = std::max(largest, histogram[p]);
+    }
+    bool isCandidate = histogram[ALL_GREEN_PATTERN] > 0;
+    return {guess, largest, isCandidate};
+}
+
+// Guesses whose worst bucket is smallest, best first
+static std::pmr::vector<BucketRank> topGuessesByLargestBucket(const SolverDictionary& dict, std::span<const int> candidates, int beamWidth, bool parallel, std::pmr::memory_resource *resource) {
+    std::pmr::vector<BucketRank> ranks(dict.size(), resource);
+    auto rankRange = [&](int begin, int end) {
+        PatternHistogram histogram;
+        for (int g = begin; g < end; ++g) {
+            ranks[g] = rankGuessByLargestBucket(dict, g, candidates, histogram);
+        }
+    };
+    if (parallel) {
+        parallelFor(dict.size(), rankRange);
+    } else {
+        rankRange(0, dict.size());
+    }
+    keepTop(ranks, beamWidth, bucketRankLess);
+    return ranks;
+}
+
+static int adversarialDepth(const SolverDictionary& dict, std::span<const int> candidates, int depthLeft, int beamWidth, int& bestGuess, bool parallel);
+
+static int evaluateAdversarialGuess(const SolverDictionary& dict, std::span<const int> candidates, int guess, int depthLeft, int beamWidth) {
+    // Everything below this node is rewound once its depth is known
+    ArenaScope scope;
+    FeedbackPartition partition(scope.resource());
+    partitionByFeedback(dict, guess, candidates, partition);
+    int pattern = adversaryPattern(partition);
+    if (pattern == ALL_GREEN_PATTERN) return 1;
+    // Guesses that split nothing can never shorten the game
+    if (partition.bucketSize(pattern) == static_cast<int>(candidates.size()) || depthLeft <= 1) return depthLeft + 1;
+    int unused;
+    return 1 + adversarialDepth(dict, partition.bucketView(pattern), depthLeft - 1, beamWidth, unused, false);
+}
+
+// Returns guesses needed to force an all-green row, or depthLeft + 1 when it cannot be done in time
+static int adversarialDepth(const SolverDictionary& dict, std::span<const int> candidates, int depthLeft, int beamWidth, int& bestGuess, bool parallel) {
+    bestGuess = -1;
+    if (candidates.size() == 1) {
+        bestGuess = candidates.front();
+        return 1;
+    }
+    if (candidates.empty() || depthLeft <= 0) return depthLeft + 1;
+
+    ArenaScope scope;
+    std::pmr::vector<BucketRank> beam = topGuessesByLargestBucket(dict, candidates, beamWidth, parallel, scope.resource());
+    int best = depthLeft + 1;
+    if (parallel) {
+        std::pmr::vector<int> depths(beam.size(), scope.resource());
+        parallelFor(static_cast<int>(beam.size()), [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                depths[i] = evaluateAdversarialGuess(dict, candidates, beam[i].guess, depthLeft, beamWidth);
+            }
+        });
+        for (size_t i = 0; i < beam.size(); ++i) {
+            if (depths[i] < best) {
+                best = depths[i];
+                bestGuess = beam[i].guess;
+            }
+        }
+    } else {
+        for (const BucketRank& rank : beam) {
+            // Only a strictly shorter line is interesting, so shrink the budget as we improve
+            int depth = evaluateAdversarialGuess(dict, candidates, rank.guess, best - 1, beamWidth);
+            if (depth < best) {
+                best = depth;
+                bestGuess = rank.guess;
+                if (best == 1) break;
+            }
+        }
+    }
+    if (bestGuess < 0 && !beam.empty()) bestGuess = beam.front().guess;
+    return best;
+}
+
+AdversarialPlan findAdversarialGuess(const SolverDictionary& dict, const CandidateSet& candidates, int maxDepth, int beamWidth) {
+    AdversarialPlan plan;
+    plan.worstCaseDepth = adversarialDepth(dict, candidates.toList(), maxDepth, beamWidth, plan.guess, true);
+    return plan;
+}
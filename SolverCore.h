@@ -0,0 +1,493 @@
+#ifndef SOLVERCORE_H
+#define SOLVERCORE_H
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Qt-free solver core shared by the windows. Words are packed into letter
+// indices once at load time so the feedback and partition loops never touch
+// QString or QMap.
+
+constexpr int WORD_LENGTH = 5;
+constexpr int MAX_ALPHABET_SIZE = 64; // letters are dense indices, so masks fit one LetterMask
+constexpr int PATTERN_COUNT = 243; // 3^5 feedback patterns
+constexpr uint8_t ALL_GREEN_PATTERN = 242;
+constexpr int LOOKAHEAD_WIDTH = 20; // entropy leaders the two-step mode looks past
+constexpr int MAX_GUESSES = 5; // rows the game allows; a game not solved by then is lost
+
+using PackedWord = std::array<uint8_t, WORD_LENGTH>;
+using CandidateList = std::vector<int>; // dictionary indices
+using PatternHistogram = std::array<int, PATTERN_COUNT>;
+using LetterMask = uint64_t;
+
+// Dictionary-indexed bitset, one bit per word. Copies and set algebra touch
+// universe/64 words instead of rebuilding hash sets, and iteration runs in
+// dictionary order. Both operands of a set operation share one universe.
+class CandidateSet {
+public:
+    CandidateSet() = default;
+    explicit CandidateSet(int universe) : bitCount(universe), blocks((universe + 63) / 64, 0) {}
+    static CandidateSet range(int universe, int begin, int end);
+    static CandidateSet fromList(int universe, std::span<const int> list);
+
+    int universe() const { return bitCount; }
+    int count() const;
+    bool empty() const;
+    bool contains(int index) const { return (blocks[index >> 6] >> (index & 63)) & 1; }
+    void insert(int index) { blocks[index >> 6] |= uint64_t(1) << (index & 63); }
+    void erase(int index) { blocks[index >> 6] &= ~(uint64_t(1) << (index & 63)); }
+    int first() const; // -1 when empty
+
+    CandidateSet& operator&=(const CandidateSet& other);
+    CandidateSet& operator|=(const CandidateSet& other);
+    CandidateSet& andNot(const CandidateSet& other); // drops every member of other
+    friend CandidateSet operator&(CandidateSet a, const CandidateSet& b) { return a &= b; }
+    friend CandidateSet operator|(CandidateSet a, const CandidateSet& b) { return a |= b; }
+    bool operator==(const CandidateSet& other) const = default;
+
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (size_t b = 0; b < blocks.size(); ++b) {
+            for (uint64_t bits = blocks[b]; bits; bits &= bits - 1) {
+                fn(static_cast<int>(b * 64 + std::countr_zero(bits)));
+            }
+        }
+    }
+    CandidateList toList() const;
+    uint64_t hash() const;
+
+private:
+    int bitCount = 0;
+    std::vector<uint64_t> blocks;
+};
+
+// Upper-case letters in use, mapped to dense indices at load time so localized
+// lists (Ñ, umlauts, Greek, Cyrillic) run through the same fixed-size kernels.
+// Indices follow code point order, which puts A-Z at 0-25 for English lists.
+class SolverAlphabet {
+public:
+    int size() const { return static_cast<int>(symbols.size()); }
+    char32_t symbol(int index) const { return symbols[index]; }
+    int indexOf(char32_t symbol) const;
+    // Returns the symbol's index, or -1 once MAX_ALPHABET_SIZE symbols are in use
+    int add(char32_t symbol);
+    // Re-sorts symbols into code point order; returns old index -> new index
+    std::vector<uint8_t> sortSymbols();
+
+private:
+    std::vector<char32_t> symbols;
+    std::unordered_map<char32_t, int> indexBySymbol;
+};
+
+// Simple case folding for Latin-1, Latin Extended-A, Greek and Cyrillic
+char32_t foldToUpper(char32_t symbol);
+bool isWordLetter(char32_t symbol); // expects an upper-cased symbol
+// Decodes [begin, end) as UTF-8; false on malformed input
+bool decodeUtf8(const char *begin, const char *end, std::u32string& decoded);
+void appendUtf8(std::string& out, char32_t symbol);
+
+// Answers occupy indices [0, answerCount), accepted-only words follow
+struct SolverDictionary {
+    SolverAlphabet alphabet;
+    std::vector<std::string> words; // upper case, UTF-8
+    std::vector<PackedWord> packed;
+    std::unordered_map<std::string, int> indexByWord;
+    int answerCount = 0;
+
+    int size() const { return static_cast<int>(words.size()); }
+    int indexOf(const std::string& word) const;
+    CandidateSet allAnswers() const;
+    CandidateSet allAccepted() const; // accepted-only words
+};
+
+SolverDictionary buildSolverDictionary(const std::vector<std::string>& answers, const std::vector<std::string>& accepted);
+
+// Pattern codes use one base-3 digit per position (0=gray, 1=yellow, 2=green),
+// position 0 least significant. Same semantics as feedbackFor in the game window.
+uint8_t computeFeedback(const PackedWord& guess, const PackedWord& answer);
+std::string patternToString(uint8_t pattern); // "GYXXG" form
+int patternFromString(const std::string& feedback); // -1 if malformed
+
+void feedbackHistogram(const SolverDictionary& dict, int guess, std::span<const int> candidates, PatternHistogram& histogram);
+
+// Answers in candidates that would have produced pattern for guess
+CandidateSet filterByFeedback(const SolverDictionary& dict, const CandidateSet& candidates, int guess, uint8_t pattern);
+
+// Feedback with unknown tiles: bit p is set for every full pattern p the row could
+// have been. Parsed from "G?XY?" ('?' for a tile whose color is not known).
+using PatternMask = std::bitset<PATTERN_COUNT>;
+bool patternMaskFromString(const std::string& feedback, PatternMask& mask); // false if malformed
+
+// Answers whose feedback to guess is any allowed pattern. Every answer gives exactly
+// one pattern, so with a uniform prior the posterior after a partial row is uniform
+// over the union of the allowed buckets; a fully unknown row returns candidates as is.
+CandidateSet filterByPatterns(const SolverDictionary& dict, const CandidateSet& candidates, int guess, const PatternMask& allowed);
+
+// Letter masks use bit (letter index); green holds a letter index or -1.
+// Mirrors the inputs of getAllValidWordsWithConstraints.
+struct SolverConstraints {
+    std::array<int, WORD_LENGTH> green{-1, -1, -1, -1, -1};
+    std::array<LetterMask, WORD_LENGTH> yellowForbidden{}; // letters seen yellow at each position
+    LetterMask yellowLetters = 0;
+    LetterMask grayLetters = 0;
+
+    bool isEmpty() const;
+};
+
+// Same acceptance rule as getAllValidWordsWithConstraints (yellow letters are not required)
+bool matchesConstraints(const PackedWord& word, const SolverConstraints& constraints);
+// Answers that match and also contain every yellow letter; the pool the rankings score against
+CandidateSet possibleAnswers(const SolverDictionary& dict, const SolverConstraints& constraints);
+
+// Counting-sort layout: bucket p is members[offsets[p], offsets[p + 1]).
+// Searches build partitions on a SolverArena; the default is the global heap.
+struct FeedbackPartition {
+    explicit FeedbackPartition(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) : members(resource) {}
+
+    std::array<int, PATTERN_COUNT + 1> offsets{};
+    std::pmr::vector<int> members;
+
+    int bucketSize(int pattern) const { return offsets[pattern + 1] - offsets[pattern]; }
+    std::span<const int> bucketView(int pattern) const { return {members.data() + offsets[pattern], members.data() + offsets[pattern + 1]}; }
+    CandidateList bucket(int pattern) const;
+};
+
+void partitionByFeedback(const SolverDictionary& dict, int guess, std::span<const int> candidates, FeedbackPartition& partition);
+
+// Ranking metrics all come out of the same feedback histogram pass
+enum class RankingMode {
+    Heuristic,    // letter-frequency score from getAllValidWordsWithConstraints
+    Entropy,      // expected information in bits, higher is better
+    Minimax,      // largest remaining bucket, lower is better
+    ExpectedSize, // expected remaining candidates, lower is better
+    Lookahead     // expected candidates left after the best second guess, lower is better
+};
+
+// Command-line names: heuristic, entropy, minimax, expected-size, lookahead
+const char *rankingModeName(RankingMode mode);
+bool rankingModeFromName(const std::string& name, RankingMode& mode);
+
+struct GuessMetrics {
+    int guess = -1;
+    bool isCandidate = false;
+    double entropy = 0.0;
+    int worstBucket = 0;
+    double expectedSize = 0.0;
+    // Only the LOOKAHEAD_WIDTH entropy leaders get a lookahead score; a pruned guess
+    // keeps the lower bound that ruled it out of the first page
+    double lookaheadSize = std::numeric_limits<double>::infinity();
+    bool lookaheadBound = false;
+};
+
+GuessMetrics metricsFromHistogram(int guess, const PatternHistogram& histogram, int total);
+bool rankedBefore(const GuessMetrics& a, const GuessMetrics& b, RankingMode mode);
+
+struct GuessOrder {
+    RankingMode mode = RankingMode::Entropy;
+    bool operator()(const GuessMetrics& a, const GuessMetrics& b) const { return rankedBefore(a, b, mode); }
+};
+
+// Keeps the best `capacity` items seen so far in a heap whose top is the worst kept item
+template <typename T, typename Before>
+class BoundedTopK {
+public:
+    BoundedTopK(int capacity, Before before) : capacity(capacity), before(before) { heap.reserve(capacity); }
+
+    void push(const T& item) {
+        if (capacity <= 0) return;
+        if (static_cast<int>(heap.size()) < capacity) {
+            heap.push_back(item);
+            std::push_heap(heap.begin(), heap.end(), before);
+        } else if (before(item, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), before);
+            heap.back() = item;
+            std::push_heap(heap.begin(), heap.end(), before);
+        }
+    }
+
+    void merge(const BoundedTopK& other) {
+        for (const T& item : other.heap) push(item);
+    }
+
+    bool full() const { return static_cast<int>(heap.size()) >= capacity; }
+    const T& worst() const { return heap.front(); } // the item the next better one evicts
+
+    // Best first
+    std::vector<T> sorted() const {
+        std::vector<T> items = heap;
+        std::sort_heap(items.begin(), items.end(), before);
+        return items;
+    }
+
+private:
+    int capacity;
+    Before before;
+    std::vector<T> heap;
+};
+
+// Every scored item, sorted lazily: only the prefix a caller has paged through is ordered,
+// so asking for more results never rescores
+template <typename T, typename Before>
+class RankedResults {
+public:
+    RankedResults(Before before = Before()) : before(before) {}
+    RankedResults(std::vector<T> items, Before before, int sortedPrefix = 0)
+        : items(std::move(items)), sortedCount(sortedPrefix), before(before) {}
+
+    int size() const { return static_cast<int>(items.size()); }
+    bool empty() const { return items.empty(); }
+
+    std::vector<T> page(int offset, int count) {
+        int end = std::min(size(), offset + count);
+        if (offset >= end) return {};
+        if (end > sortedCount) {
+            std::partial_sort(items.begin() + sortedCount, items.begin() + end, items.end(), before);
+            sortedCount = end;
+        }
+        return std::vector<T>(items.begin() + offset, items.begin() + end);
+    }
+
+private:
+    std::vector<T> items;
+    int sortedCount = 0;
+    Before before;
+};
+
+// Partial selection for callers that only want the head of a list
+template <typename T, typename Alloc, typename Before>
+void keepTop(std::vector<T, Alloc>& items, int count, Before before) {
+    int keep = std::min(count, static_cast<int>(items.size()));
+    std::partial_sort(items.begin(), items.begin() + keep, items.end(), before);
+    items.resize(keep);
+}
+
+using GuessRanking = RankedResults<GuessMetrics, GuessOrder>;
+
+// Scores every dictionary word against candidates across cores. Each worker keeps a
+// local top-firstPage heap; the merged heads come back already ordered. Lookahead
+// re-scores the LOOKAHEAD_WIDTH entropy leaders, which then head the ranking.
+GuessRanking rankGuesses(const SolverDictionary& dict, std::span<const int> candidates, RankingMode mode, int firstPage, bool parallel = true);
+
+// Feedback of every dictionary word (rows) against a set of answers (columns), one
+// byte per pair: 243 codes need all 8 bits, so a byte is already the packed form.
+// The full matrix is about 30 MB for the default lists; compact() copies out the
+// columns of a narrower candidate set so they sit side by side, and a few filters in
+// the whole matrix fits in L2/L3. Ranking reads it in bands of rows sized to L2.
+class PatternMatrix {
+public:
+    PatternMatrix() = default;
+    static PatternMatrix build(const SolverDictionary& dict); // every answer as a column
+    // Whether dict's full matrix stays within MAX_BYTES; larger lists rank without one
+    static bool fits(const SolverDictionary& dict);
+    static constexpr size_t MAX_BYTES = size_t(512) << 20;
+
+    // candidates must all be columns; they come out in dictionary order
+    PatternMatrix compact(const CandidateSet& candidates) const;
+    bool covers(const CandidateSet& candidates) const;
+
+    int rowCount() const { return rows; }
+    const CandidateList& columns() const { return columnList; } // answer index per column
+    const CandidateSet& columnSet() const { return columnBits; }
+    const uint8_t *row(int guess) const { return patterns.data() + static_cast<size_t>(guess) * columnList.size(); }
+    size_t bytes() const { return patterns.size(); }
+
+private:
+    int rows = 0;
+    CandidateList columnList;
+    CandidateSet columnBits;
+    std::vector<uint8_t> patterns; // row-major, rows x columns
+};
+
+// Same ranking as above with the histograms read from patterns instead of computed;
+// the candidates are its columns
+GuessRanking rankGuesses(const SolverDictionary& dict, const PatternMatrix& patterns, RankingMode mode, int firstPage, bool parallel = true);
+
+// Approximate ranking for very large lists, by successive halving. Every guess is
+// scored on a stratified sample of the candidates (drawn from each first letter in
+// proportion), the better 1/keepFactor kept and the sample doubled, until few guesses
+// are left or the sample would cover every candidate; the survivors are then scored
+// exactly. The ranking holds the survivors in exact order, then the dropped guesses
+// with their sample estimates, the last dropped first.
+struct SampledRankingOptions {
+    int initialSample = 512;
+    int keepFactor = 2;
+    int minSurvivors = 64; // raised to 4 * firstPage and LOOKAHEAD_WIDTH
+};
+
+struct SampledRankingReport {
+    int rounds = 0;            // sampled rounds before the exact one
+    long long pairsScored = 0; // guess x candidate feedbacks, sampled and exact
+    int exactGuesses = 0;      // survivors scored on every candidate
+    // Estimated chance that no dropped guess belonged on the first page: one minus the
+    // summed normal-approximation odds that each beat the firstPage-th best estimate
+    // of its round
+    double confidence = 1.0;
+};
+
+GuessRanking rankGuessesSampled(const SolverDictionary& dict, std::span<const int> candidates, RankingMode mode, int firstPage,
+                                const SampledRankingOptions& options, SampledRankingReport& report, bool parallel = true);
+
+// Past this many guess x candidate pairs cachedRankGuesses samples instead of ranking
+// exactly; the default lists (some 30M pairs at most) stay exact
+constexpr long long EXACT_RANKING_PAIRS = 200'000'000;
+
+// Rankings keyed by (candidate set, mode), shared between the UI thread and
+// background pre-warming. Least recently used entries are evicted past capacity.
+class SolverCache {
+public:
+    explicit SolverCache(size_t capacity = 64) : capacity(capacity) {}
+
+    bool lookup(const CandidateSet& candidates, RankingMode mode, GuessRanking& ranking);
+    void store(const CandidateSet& candidates, RankingMode mode, const GuessRanking& ranking);
+    bool contains(const CandidateSet& candidates, RankingMode mode);
+    void clear();
+
+    // Full pattern matrix to rank from on a miss (none by default, then feedback is
+    // computed). patternsFor compacts it, or the last compacted matrix when that
+    // still covers candidates, so a game's successive filters keep narrowing one copy.
+    void setPatternMatrix(std::shared_ptr<const PatternMatrix> patterns);
+    std::shared_ptr<const PatternMatrix> patternsFor(const CandidateSet& candidates);
+
+private:
+    struct Entry {
+        CandidateSet candidates;
+        RankingMode mode;
+        GuessRanking ranking;
+        uint64_t lastUse;
+    };
+    static uint64_t keyFor(const CandidateSet& candidates, RankingMode mode);
+
+    std::mutex mutex;
+    std::unordered_map<uint64_t, Entry> entries;
+    std::shared_ptr<const PatternMatrix> fullPatterns;
+    std::shared_ptr<const PatternMatrix> narrowPatterns; // last compacted
+    size_t capacity;
+    uint64_t useClock = 0;
+};
+
+GuessRanking cachedRankGuesses(const SolverDictionary& dict, const CandidateSet& candidates, RankingMode mode, int firstPage, SolverCache& cache);
+
+// Ranks the follow-up states for the most probable feedbacks to guess (largest
+// buckets first) and stores them in cache. Runs single-threaded so it can sit on an
+// idle worker; returns early once cancelled() reports true.
+void prewarmFollowUps(const SolverDictionary& dict, const CandidateSet& candidates, int guess, RankingMode mode, int maxBuckets, SolverCache& cache, const std::function<bool()>& cancelled);
+
+// Post-game accounting for one guess: the information it actually gained next to what
+// it was expected to gain and what the best (entropy) guess in that position expected
+struct MoveAnalysis {
+    int guess = -1;
+    uint8_t pattern = 0;
+    int candidatesBefore = 0;
+    int candidatesAfter = 0;
+    double bitsGained = 0.0;   // log2(before / after)
+    double expectedBits = 0.0; // entropy of guess over the candidates before
+    int bestGuess = -1;
+    double bestExpectedBits = 0.0;
+};
+
+// Replays a finished game from the full answer list by narrowing the candidate set
+// with each feedback. Best guesses come through cache, so positions ranked during
+// play (hints, pre-warming, earlier games) cost a lookup.
+std::vector<MoveAnalysis> analyzeGame(const SolverDictionary& dict, std::span<const int> guesses, std::span<const uint8_t> patterns, SolverCache& cache);
+
+// Per-thread scratch memory for search temporaries (partitions, beams, histograms).
+// Allocation bumps a pointer through chunks that are kept across requests, so once
+// warm a search never touches the global allocator and threads never contend.
+// Memory is reclaimed only by rewinding to a mark, which ArenaScope does on exit.
+class SolverArena : public std::pmr::memory_resource {
+public:
+    struct Mark {
+        size_t chunk = 0;
+        size_t offset = 0;
+        size_t inUse = 0;
+    };
+
+    static SolverArena& forThread();
+    ~SolverArena() override;
+
+    Mark mark() const { return {current, offset, inUse}; }
+    void release(const Mark& mark);
+    size_t bytesInUse() const { return inUse; }
+    size_t peakBytes() const; // since the last resetSolverArenaStats()
+
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+    std::vector<Chunk> chunks;
+    size_t current = 0;
+    size_t offset = 0;
+    size_t inUse = 0;
+    size_t peak = 0;
+    size_t peakEpoch = 0; // resets seen; a newer one restarts peak
+};
+
+// Rewinds the calling thread's arena to where it stood on entry; opened once per
+// request and once per search node so recursion reuses memory like a stack
+class ArenaScope {
+public:
+    ArenaScope() : arena(SolverArena::forThread()), start(arena.mark()) {}
+    ~ArenaScope() { arena.release(start); }
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    std::pmr::memory_resource *resource() { return &arena; }
+
+private:
+    SolverArena& arena;
+    SolverArena::Mark start;
+};
+
+// Totals across every thread's arena since the last reset
+struct ArenaStats {
+    size_t peakBytes = 0;           // largest single-thread high-water mark since the reset
+    size_t reservedBytes = 0;       // chunk memory currently held by live arenas
+    size_t upstreamAllocations = 0; // chunks taken from the global allocator since the reset
+};
+
+ArenaStats solverArenaStats();
+// Restarts the peaks, every thread's own included, and the allocation count
+void resetSolverArenaStats();
+
+// Runs body over contiguous chunks of [0, count) on a persistent worker pool. Chunks
+// are handed out on demand so uneven work balances, and the caller takes chunks
+// too, so a body may call parallelFor again without deadlocking.
+void parallelFor(int count, const std::function<void(int begin, int end)>& body);
+
+// Adversarial (Absurdle-style) engine: the answer is never fixed, after each
+// guess the adversary keeps the largest feedback bucket.
+struct AdversaryResponse {
+    uint8_t pattern = 0;
+    CandidateSet remaining;
+};
+
+struct AdversarialPlan {
+    int guess = -1;
+    // Guesses needed including the final all-green one; more than maxDepth when no
+    // forced win fits, and guess is then just the most promising one
+    int worstCaseDepth = 0;
+};
+
+AdversaryResponse adversarialResponse(const SolverDictionary& dict, int guess, const CandidateSet& candidates);
+// maxDepth is the guesses left to play
+AdversarialPlan findAdversarialGuess(const SolverDictionary& dict, const CandidateSet& candidates, int maxDepth = MAX_GUESSES, int beamWidth = 8);
+
+#endif // SOLVERCORE_H
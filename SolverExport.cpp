@@ -0,0 +1,149 @@
+#include "SolverExport.h"
+#include <fstream>
+
+namespace {
+
+const char LINES_MAGIC[4] = {'W', 'L', 'I', 'N'};
+const uint32_t LINES_VERSION = 1;
+const uint32_t NO_WORD = 0xFFFFFFFFu;
+const int MAX_TREE_DEPTH = 32; // far past any line; only a strategy that stops splitting gets here
+
+struct TreeNode {
+    CandidateSet candidates;
+    std::vector<GuessMetrics> best;       // head of the ranking, best first
+    std::array<int, PATTERN_COUNT> child; // node after each feedback to best[0], -1 if none
+};
+
+// The number the ranking itself ordered by
+float rankingScore(const GuessMetrics& metrics, RankingMode mode) {
+    switch (mode) {
+    case RankingMode::Minimax: return static_cast<float>(metrics.worstBucket);
+    case RankingMode::ExpectedSize: return static_cast<float>(metrics.expectedSize);
+    case RankingMode::Lookahead: return static_cast<float>(metrics.lookaheadSize);
+    default: return static_cast<float>(metrics.entropy);
+    }
+}
+
+void writeBytes(std::ofstream& out, const void *data, size_t size) {
+    static const char padding[4] = {};
+    out.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+    out.write(padding, static_cast<std::streamsize>((4 - size % 4) % 4));
+}
+
+template <typename T>
+void writeColumn(std::ofstream& out, const std::vector<T>& column) {
+    writeBytes(out, column.data(), column.size() * sizeof(T));
+}
+
+// Positions reached by following the strategy from the full answer list
+bool buildTree(const SolverDictionary& dict, const LineExportOptions& options, std::vector<TreeNode>& nodes, std::string& error) {
+    int width = std::max(1, options.alternatives);
+    nodes.assign(1, TreeNode{dict.allAnswers(), {}, {}});
+    std::vector<int> level = {0};
+    for (int depth = 0; !level.empty(); ++depth) {
+        if (depth == MAX_TREE_DEPTH) {
+            error = std::string("The ") + rankingModeName(options.mode) + " strategy does not narrow every position";
+            return false;
+        }
+        // A lone position (the opening) is ranked across cores, a wide level one position per core
+        bool rankInParallel = level.size() == 1;
+        parallelFor(static_cast<int>(level.size()), [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                TreeNode& node = nodes[level[i]];
+                node.best = rankGuesses(dict, node.candidates.toList(), options.mode, width, rankInParallel).page(0, width);
+            }
+        });
+        std::vector<int> next;
+        for (int index : level) {
+            nodes[index].child.fill(-1);
+            if (nodes[index].best.empty()) continue;
+            int guess = nodes[index].best.front().guess;
+            ArenaScope scope;
+            FeedbackPartition partition(scope.resource());
+            partitionByFeedback(dict, guess, nodes[index].candidates.toList(), partition);
+            for (int pattern = 0; pattern < PATTERN_COUNT; ++pattern) {
+                if (pattern == ALL_GREEN_PATTERN || partition.bucketSize(pattern) == 0) continue;
+                nodes[index].child[pattern] = static_cast<int>(nodes.size());
+                next.push_back(static_cast<int>(nodes.size()));
+                nodes.push_back(TreeNode{CandidateSet::fromList(dict.size(), partition.bucketView(pattern)), {}, {}});
+            }
+        }
+        level = std::move(next);
+    }
+    return true;
+}
+
+} // namespace
+
+bool exportPlayLines(const SolverDictionary& dict, const LineExportOptions& options, const std::string& path,
+                     LineExportSummary& summary, std::string& error) {
+    summary = LineExportSummary();
+    if (dict.answerCount == 0) {
+        error = "No answers to export";
+        return false;
+    }
+    std::vector<TreeNode> nodes;
+    if (!buildTree(dict, options, nodes, error)) return false;
+
+    int width = std::max(1, options.alternatives);
+    std::vector<uint32_t> firstStep = {0};
+    std::vector<uint32_t> guesses, candidates, alternatives;
+    std::vector<uint8_t> patterns;
+    std::vector<float> scores;
+    for (int answer = 0; answer < dict.answerCount; ++answer) {
+        int node = 0;
+        int length = 0;
+        while (node >= 0 && !nodes[node].best.empty()) {
+            const TreeNode& position = nodes[node];
+            int guess = position.best.front().guess;
+            uint8_t pattern = computeFeedback(dict.packed[guess], dict.packed[answer]);
+            guesses.push_back(static_cast<uint32_t>(guess));
+            patterns.push_back(pattern);
+            candidates.push_back(static_cast<uint32_t>(position.candidates.count()));
+            for (int k = 0; k < width; ++k) {
+                bool present = k < static_cast<int>(position.best.size());
+                alternatives.push_back(present ? static_cast<uint32_t>(position.best[k].guess) : NO_WORD);
+                scores.push_back(present ? rankingScore(position.best[k], options.mode) : 0.0f);
+            }
+            ++length;
+            node = pattern == ALL_GREEN_PATTERN ? -1 : position.child[pattern];
+        }
+        firstStep.push_back(static_cast<uint32_t>(guesses.size()));
+        summary.longestLine = std::max(summary.longestLine, length);
+    }
+
+    std::vector<uint32_t> wordOffsets = {0};
+    std::string wordBytes;
+    for (const std::string& word : dict.words) {
+        wordBytes += word;
+        wordOffsets.push_back(static_cast<uint32_t>(wordBytes.size()));
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        error = "Could not write " + path;
+        return false;
+    }
+    std::vector<uint32_t> header = {LINES_VERSION, static_cast<uint32_t>(dict.size()), static_cast<uint32_t>(dict.answerCount),
+                                    static_cast<uint32_t>(guesses.size()), static_cast<uint32_t>(width),
+                                    static_cast<uint32_t>(options.mode)};
+    writeBytes(out, LINES_MAGIC, sizeof(LINES_MAGIC));
+    writeColumn(out, header);
+    writeColumn(out, wordOffsets);
+    writeBytes(out, wordBytes.data(), wordBytes.size());
+    writeColumn(out, firstStep);
+    writeColumn(out, guesses);
+    writeColumn(out, patterns);
+    writeColumn(out, candidates);
+    writeColumn(out, alternatives);
+    writeColumn(out, scores);
+    if (!out) {
+        error = "Short write to " + path;
+        return false;
+    }
+
+    summary.positions = static_cast<int>(nodes.size());
+    summary.steps = static_cast<int>(guesses.size());
+    summary.meanGuesses = static_cast<double>(guesses.size()) / dict.answerCount;
+    return true;
+}
@@ -0,0 +1,41 @@
+#ifndef SOLVEREXPORT_H
+#define SOLVEREXPORT_H
+
+#include "SolverCore.h"
+#include <string>
+
+// Precomputed play for every answer, for serving hints statically. The strategy's
+// decision tree is built once, breadth first, with each level's positions ranked in
+// parallel; every answer's line is then a walk down that tree.
+//
+// File layout (host byte order, little-endian on every supported platform), one
+// column after another, each zero-padded to a 4-byte boundary so a reader can map
+// any column directly (typed arrays, mmap):
+//   char[4]  magic "WLIN"
+//   uint32   version, word count, answer count, step count, alternatives per step (K),
+//            ranking mode (RankingMode value: 1 entropy, 2 minimax, 3 expected size, 4 lookahead)
+//   uint32   word offsets[word count + 1] into the word bytes that follow
+//   char     word bytes (UTF-8, upper case, not terminated)
+//   uint32   first step of each answer[answer count + 1]; answer a owns steps [first[a], first[a + 1])
+//   uint32   guess[step count]             word index played at the step
+//   uint8    pattern[step count]           feedback digits, base 3, position 0 least significant
+//   uint32   candidates[step count]        answers still possible before the guess
+//   uint32   alternative[step count * K]   best K guesses at the step, best first; 0xFFFFFFFF pads
+//   float32  alternativeScore[step count * K]  the ranking's own metric (bits, bucket size, ...)
+// The played guess is always alternative 0.
+struct LineExportOptions {
+    RankingMode mode = RankingMode::Entropy;
+    int alternatives = 5;
+};
+
+struct LineExportSummary {
+    int positions = 0; // distinct decision points ranked
+    int steps = 0;
+    int longestLine = 0;
+    double meanGuesses = 0.0;
+};
+
+bool exportPlayLines(const SolverDictionary& dict, const LineExportOptions& options, const std::string& path,
+                     LineExportSummary& summary, std::string& error);
+
+#endif // SOLVEREXPORT_H
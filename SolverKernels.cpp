@@ -0,0 +1,135 @@
+#include "SolverKernels.h"
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(WORDLE_X86_KERNELS)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+// Each defined in its own file, built for that instruction set
+void feedbackRowSse2(const PackedWord& guess, const uint8_t *const planes[WORD_LENGTH], size_t count, uint8_t *out);
+void feedbackRowAvx2(const PackedWord& guess, const uint8_t *const planes[WORD_LENGTH], size_t count, uint8_t *out);
+void feedbackRowAvx512(const PackedWord& guess, const uint8_t *const planes[WORD_LENGTH], size_t count, uint8_t *out);
+#endif
+
+static const std::pair<SimdLevel, const char *> SIMD_LEVEL_NAMES[] = {
+    {SimdLevel::Scalar, "scalar"},
+    {SimdLevel::Sse2, "sse2"},
+    {SimdLevel::Avx2, "avx2"},
+    {SimdLevel::Avx512, "avx512"},
+};
+
+const char *simdLevelName(SimdLevel level) {
+    for (const auto& [candidate, name] : SIMD_LEVEL_NAMES) {
+        if (candidate == level) return name;
+    }
+    return "scalar";
+}
+
+bool simdLevelFromName(const std::string& name, SimdLevel& level) {
+    for (const auto& [candidate, candidateName] : SIMD_LEVEL_NAMES) {
+        if (name == candidateName) {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void feedbackRowScalar(const PackedWord& guess, const uint8_t *const planes[WORD_LENGTH], size_t count, uint8_t *out) {
+    for (size_t c = 0; c < count; ++c) {
+        PackedWord answer;
+        for (int i = 0; i < WORD_LENGTH; ++i) answer[i] = planes[i][c];
+        out[c] = computeFeedback(guess, answer);
+    }
+}
+
+#if defined(WORDLE_X86_KERNELS)
+static SimdLevel detectX86Level() {
+#if defined(_MSC_VER)
+    // AVX needs the OS to save the wide registers too (XCR0), not just the CPUID bits
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    bool osSavesAvx = (info[2] & (1 << 27)) != 0;
+    unsigned long long xcr0 = osSavesAvx ? _xgetbv(0) : 0;
+    if (maxLeaf < 7 || (xcr0 & 0x6) != 0x6) return SimdLevel::Sse2;
+    __cpuidex(info, 7, 0);
+    bool avx2 = (info[1] & (1 << 5)) != 0;
+    bool avx512 = (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 30)) != 0 && (xcr0 & 0xE6) == 0xE6;
+    if (avx512) return SimdLevel::Avx512;
+    return avx2 ? SimdLevel::Avx2 : SimdLevel::Sse2;
+#else
+    // The builtins fold in the OS register-state checks
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) return SimdLevel::Avx512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+    return SimdLevel::Sse2;
+#endif
+}
+#endif
+
+SimdLevel supportedSimdLevel() {
+#if defined(WORDLE_X86_KERNELS)
+    static const SimdLevel level = detectX86Level();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+bool requestedSimdLevel(SimdLevel& level, std::string& error) {
+    level = supportedSimdLevel();
+    const char *env = std::getenv("WORDLE_SIMD_LEVEL");
+    if (!env || simdLevelFromName(env, level)) return true;
+    error = std::string("WORDLE_SIMD_LEVEL=") + env + " is not one of scalar, sse2, avx2, avx512";
+    return false;
+}
+
+SimdLevel activeSimdLevel() {
+    static const SimdLevel level = [] {
+        SimdLevel requested;
+        std::string error;
+        if (!requestedSimdLevel(requested, error)) {
+            std::fprintf(stderr, "%s; using %s\n", error.c_str(), simdLevelName(requested));
+        }
+        return std::min(requested, supportedSimdLevel());
+    }();
+    return level;
+}
+
+FeedbackRowKernel feedbackRowKernel(SimdLevel level) {
+    if (level > supportedSimdLevel()) return nullptr;
+    switch (level) {
+#if defined(WORDLE_X86_KERNELS)
+    case SimdLevel::Sse2: return feedbackRowSse2;
+    case SimdLevel::Avx2: return feedbackRowAvx2;
+    case SimdLevel::Avx512: return feedbackRowAvx512;
+#endif
+    case SimdLevel::Scalar: return feedbackRowScalar;
+    default: return nullptr;
+    }
+}
+
+void feedbackRow(const PackedWord& guess, const uint8_t *const planes[WORD_LENGTH], size_t count, uint8_t *out) {
+    static const FeedbackRowKernel kernel = feedbackRowKernel(activeSimdLevel());
+    kernel(guess, planes, count, out);
+}
+
+LetterPlanes LetterPlanes::gather(const SolverDictionary& dict, std::span<const int> candidates) {
+    LetterPlanes planes;
+    for (int i = 0; i < WORD_LENGTH; ++i) {
+        planes.letters[i].resize(candidates.size());
+        for (size_t c = 0; c < candidates.size(); ++c) planes.letters[i][c] = dict.packed[candidates[c]][i];
+    }
+    return planes;
+}
+
+void LetterPlanes::row(const PackedWord& guess, uint8_t *out) const {
+    const uint8_t *planes[WORD_LENGTH];
+    for (int i = 0; i < WORD_LENGTH; ++i) planes[i] = letters[i].data();
+    feedbackRow(guess, planes, count(), out);
+}
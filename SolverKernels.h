@@ -0,0 +1,41 @@
+#ifndef SOLVERKERNELS_H
+#define SOLVERKERNELS_H
+
+#include "SolverCore.h"
+
+// Feedback of one guess against many answers at once. Answers are given as letter
+// planes, planes[i][c] being letter i of answer c, so one vector compare covers 16
+// (SSE2), 32 (AVX2) or 64 (AVX-512) answers. The variants are built for their own
+// instruction sets and the fastest one the CPU runs is picked on first use; set
+// WORDLE_SIMD_LEVEL to scalar, sse2, avx2 or avx512 to cap it, e.g. for testing.
+enum class SimdLevel { Scalar, Sse2, Avx2, Avx512 };
+
+using FeedbackRowKernel = void (*)(const PackedWord& guess, const uint8_t *const planes[WORD_LENGTH], size_t count, uint8_t *out);
+
+const char *simdLevelName(SimdLevel level);
+bool simdLevelFromName(const std::string& name, SimdLevel& level);
+
+SimdLevel supportedSimdLevel(); // the best this build and CPU can run
+SimdLevel activeSimdLevel();    // what feedbackRow uses, after WORDLE_SIMD_LEVEL
+
+// The cap WORDLE_SIMD_LEVEL asks for, the supported level when it is unset; false
+// (with error set) when it names no level. activeSimdLevel() then warns on stderr
+// and ignores it.
+bool requestedSimdLevel(SimdLevel& level, std::string& error);
+
+// nullptr when level is not built in or the CPU lacks it
+FeedbackRowKernel feedbackRowKernel(SimdLevel level);
+
+// out[c] = computeFeedback(guess, answer c) for count answers, through the active kernel
+void feedbackRow(const PackedWord& guess, const uint8_t *const planes[WORD_LENGTH], size_t count, uint8_t *out);
+
+// Candidates' letters rearranged into planes, for scanning them with many guesses
+struct LetterPlanes {
+    std::array<std::vector<uint8_t>, WORD_LENGTH> letters;
+
+    static LetterPlanes gather(const SolverDictionary& dict, std::span<const int> candidates);
+    size_t count() const { return letters[0].size(); }
+    void row(const PackedWord& guess, uint8_t *out) const;
+};
+
+#endif // SOLVERKERNELS_H
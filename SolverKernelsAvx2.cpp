@@ -0,0 +1,26 @@
+// Built with AVX2 enabled (see CMakeLists.txt); only called once the CPU reports it
+#include "SolverKernelsSimd.h"
+#include <immintrin.h>
+
+namespace {
+
+struct Avx2Ops {
+    using Reg = __m256i;
+    static constexpr size_t WIDTH = 32;
+    static Reg load(const uint8_t *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+    static void store(uint8_t *p, Reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+    static Reg splat(uint8_t value) { return _mm256_set1_epi8(static_cast<char>(value)); }
+    static Reg zero() { return _mm256_setzero_si256(); }
+    static Reg eq(Reg a, Reg b) { return _mm256_cmpeq_epi8(a, b); }
+    static Reg gt(Reg a, Reg b) { return _mm256_cmpgt_epi8(a, b); }
+    static Reg bitAnd(Reg a, Reg b) { return _mm256_and_si256(a, b); }
+    static Reg andNot(Reg a, Reg b) { return _mm256_andnot_si256(a, b); }
+    static Reg add(Reg a, Reg b) { return _mm256_add_epi8(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm256_sub_epi8(a, b); }
+};
+
+} // namespace
+
+void feedbackRowAvx2(const PackedWord& guess, const uint8_t *const planes[WORD_LENGTH], size_t count, uint8_t *out) {
+    feedbackRowSimd<Avx2Ops>(guess, planes, count, out);
+}
@@ -0,0 +1,27 @@
+// Built with AVX-512 F and BW enabled (see CMakeLists.txt); only called once the CPU
+// reports both. Compares yield lane masks, widened back to byte masks with movm.
+#include "SolverKernelsSimd.h"
+#include <immintrin.h>
+
+namespace {
+
+struct Avx512Ops {
+    using Reg = __m512i;
+    static constexpr size_t WIDTH = 64;
+    static Reg load(const uint8_t *p) { return _mm512_loadu_si512(p); }
+    static void store(uint8_t *p, Reg v) { _mm512_storeu_si512(p, v); }
+    static Reg splat(uint8_t value) { return _mm512_set1_epi8(static_cast<char>(value)); }
+    static Reg zero() { return _mm512_setzero_si512(); }
+    static Reg eq(Reg a, Reg b) { return _mm512_movm_epi8(_mm512_cmpeq_epi8_mask(a, b)); }
+    static Reg gt(Reg a, Reg b) { return _mm512_movm_epi8(_mm512_cmpgt_epi8_mask(a, b)); }
+    static Reg bitAnd(Reg a, Reg b) { return _mm512_and_si512(a, b); }
+    static Reg andNot(Reg a, Reg b) { return _mm512_andnot_si512(a, b); }
+    static Reg add(Reg a, Reg b) { return _mm512_add_epi8(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm512_sub_epi8(a, b); }
+};
+
+} // namespace
+
+void feedbackRowAvx512(const PackedWord& guess, const uint8_t *const planes[WORD_LENGTH], size_t count, uint8_t *out) {
+    feedbackRowSimd<Avx512Ops>(guess, planes, count, out);
+}
@@ -0,0 +1,68 @@
+#ifndef SOLVERKERNELSSIMD_H
+#define SOLVERKERNELSSIMD_H
+
+#include "SolverCore.h"
+#include <cstring>
+
+// The feedback kernel written once over a vector of byte lanes. Each instruction-set
+// file instantiates it with its own Ops (a type local to that file), so the compiler
+// flags of that file apply and no inline code is shared between the variants.
+//
+// Ops provides Reg, WIDTH and: load, store, splat, zero, eq, gt (signed), bitAnd,
+// andNot (~a & b), add, sub. Masks are all-ones bytes.
+//
+// Per answer lane, with greens taken first: guess letter i is yellow when the answer
+// has more unmatched copies of it than earlier non-green guess positions already
+// claimed, which is what computeFeedback's left-to-right consumption works out to.
+template <typename Ops>
+void feedbackRowSimd(const PackedWord& guess, const uint8_t *const planes[WORD_LENGTH], size_t count, uint8_t *out) {
+    using Reg = typename Ops::Reg;
+    static const uint8_t WEIGHTS[WORD_LENGTH] = {1, 3, 9, 27, 81};
+    Reg guessLetters[WORD_LENGTH], yellowWeight[WORD_LENGTH], greenWeight[WORD_LENGTH];
+    for (int i = 0; i < WORD_LENGTH; ++i) {
+        guessLetters[i] = Ops::splat(guess[i]);
+        yellowWeight[i] = Ops::splat(WEIGHTS[i]);
+        greenWeight[i] = Ops::splat(static_cast<uint8_t>(2 * WEIGHTS[i]));
+    }
+    const Reg ones = Ops::eq(Ops::zero(), Ops::zero());
+
+    auto block = [&](const uint8_t *const rows[WORD_LENGTH], size_t offset, uint8_t *dst) {
+        Reg answer[WORD_LENGTH], green[WORD_LENGTH];
+        Reg pattern = Ops::zero();
+        for (int i = 0; i < WORD_LENGTH; ++i) {
+            answer[i] = Ops::load(rows[i] + offset);
+            green[i] = Ops::eq(answer[i], guessLetters[i]);
+            pattern = Ops::add(pattern, Ops::bitAnd(green[i], greenWeight[i]));
+        }
+        for (int i = 0; i < WORD_LENGTH; ++i) {
+            // Counts are kept negative: subtracting an all-ones mask adds one
+            Reg available = Ops::zero();
+            for (int j = 0; j < WORD_LENGTH; ++j) available = Ops::sub(available, Ops::andNot(green[j], Ops::eq(answer[j], guessLetters[i])));
+            Reg claimed = Ops::zero();
+            for (int k = 0; k < i; ++k) {
+                if (guess[k] == guess[i]) claimed = Ops::sub(claimed, Ops::andNot(green[k], ones));
+            }
+            Reg yellow = Ops::andNot(green[i], Ops::gt(available, claimed));
+            pattern = Ops::add(pattern, Ops::bitAnd(yellow, yellowWeight[i]));
+        }
+        Ops::store(dst, pattern);
+    };
+
+    size_t c = 0;
+    for (; c + Ops::WIDTH <= count; c += Ops::WIDTH) block(planes, c, out + c);
+    if (c < count) {
+        // Last partial block from zero-padded copies; the padding lanes are dropped
+        size_t left = count - c;
+        alignas(64) uint8_t tail[WORD_LENGTH][Ops::WIDTH] = {};
+        const uint8_t *tailRows[WORD_LENGTH];
+        for (int i = 0; i < WORD_LENGTH; ++i) {
+            std::memcpy(tail[i], planes[i] + c, left);
+            tailRows[i] = tail[i];
+        }
+        alignas(64) uint8_t patterns[Ops::WIDTH];
+        block(tailRows, 0, patterns);
+        std::memcpy(out + c, patterns, left);
+    }
+}
+
+#endif // SOLVERKERNELSSIMD_H
@@ -0,0 +1,26 @@
+// Built for the x86-64 baseline; SSE2 needs no extra compiler flags
+#include "SolverKernelsSimd.h"
+#include <emmintrin.h>
+
+namespace {
+
+struct Sse2Ops {
+    using Reg = __m128i;
+    static constexpr size_t WIDTH = 16;
+    static Reg load(const uint8_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+    static void store(uint8_t *p, Reg v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+    static Reg splat(uint8_t value) { return _mm_set1_epi8(static_cast<char>(value)); }
+    static Reg zero() { return _mm_setzero_si128(); }
+    static Reg eq(Reg a, Reg b) { return _mm_cmpeq_epi8(a, b); }
+    static Reg gt(Reg a, Reg b) { return _mm_cmpgt_epi8(a, b); }
+    static Reg bitAnd(Reg a, Reg b) { return _mm_and_si128(a, b); }
+    static Reg andNot(Reg a, Reg b) { return _mm_andnot_si128(a, b); }
+    static Reg add(Reg a, Reg b) { return _mm_add_epi8(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm_sub_epi8(a, b); }
+};
+
+} // namespace
+
+void feedbackRowSse2(const PackedWord& guess, const uint8_t *const planes[WORD_LENGTH], size_t count, uint8_t *out) {
+    feedbackRowSimd<Sse2Ops>(guess, planes, count, out);
+}
@@ -0,0 +1,285 @@
+#include "SolverProtocol.h"
+#include "DictionaryLoader.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+struct Session {
+    SolverConstraints constraints; // what the heuristic list filters by, as in the solver window
+    CandidateSet candidates;       // answers consistent with every row
+};
+
+// Upper case the way the dictionary stores words; empty if word is not UTF-8
+std::string upperCased(const std::string& word) {
+    std::u32string symbols;
+    if (!decodeUtf8(word.data(), word.data() + word.size(), symbols)) return std::string();
+    std::string upper;
+    for (char32_t symbol : symbols) appendUtf8(upper, foldToUpper(symbol));
+    return upper;
+}
+
+bool parseCount(const std::string& text, int& count) {
+    try {
+        size_t used = 0;
+        count = std::stoi(text, &used);
+        return used == text.size() && count > 0;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+// Reply lines in request order. Each request takes a slot when it is read and fills it
+// whenever its answer is ready; the writer thread prints the filled slots at the front
+// in one write and flushes as soon as it reaches a slot still being computed.
+class OrderedReplies {
+public:
+    explicit OrderedReplies(std::ostream& out) : out(out), writer([this]() { writeLoop(); }) {}
+    ~OrderedReplies() { finish(); }
+
+    size_t reserve() {
+        std::lock_guard<std::mutex> lock(mutex);
+        slots.emplace_back();
+        return firstSlot + slots.size() - 1;
+    }
+
+    void fill(size_t slot, std::string text) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            slots[slot - firstSlot] = {std::move(text), true};
+        }
+        changed.notify_all();
+    }
+
+    // Returns once every reserved slot is filled and written
+    void finish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closing = true;
+        }
+        changed.notify_all();
+        if (writer.joinable()) writer.join();
+    }
+
+private:
+    struct Slot {
+        std::string text;
+        bool ready = false;
+    };
+
+    void writeLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            changed.wait(lock, [this]() { return (!slots.empty() && slots.front().ready) || (closing && slots.empty()); });
+            if (slots.empty()) return;
+            std::string batch;
+            while (!slots.empty() && slots.front().ready) {
+                batch += slots.front().text;
+                slots.pop_front();
+                ++firstSlot;
+            }
+            lock.unlock();
+            out << batch;
+            out.flush();
+            lock.lock();
+        }
+    }
+
+    std::ostream& out;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<Slot> slots;
+    size_t firstSlot = 0; // request number of slots.front()
+    bool closing = false;
+    std::thread writer; // last, so it starts after the members it reads
+};
+
+// Threads for the ranked hints. Each ranking also spreads over the cores through
+// parallelFor, so a few threads are enough to keep one slow hint from holding up the rest.
+class HintWorkers {
+public:
+    HintWorkers() {
+        int count = static_cast<int>(std::clamp(std::thread::hardware_concurrency(), 2u, 4u));
+        for (int i = 0; i < count; ++i) threads.emplace_back([this]() { workLoop(); });
+    }
+
+    ~HintWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& thread : threads) thread.join();
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+        }
+        wake.notify_one();
+    }
+
+private:
+    // Queued tasks still run after stopping is set, so every slot gets filled
+    void workLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return;
+            std::function<void()> task = std::move(tasks.front());
+            tasks.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::function<void()>> tasks;
+    std::vector<std::thread> threads;
+    bool stopping = false;
+};
+
+// Sessions live on the reading thread, which answers every request but ranked hints
+// itself, in order. A ranked hint goes to a worker with a copy of its session's
+// candidates, so later rows for that session can be read meanwhile.
+class ProtocolServer {
+public:
+    ProtocolServer(const HeuristicScorer& scorer, OrderedReplies& replies) : scorer(scorer), dict(scorer.dictionary()), replies(replies) {
+        if (PatternMatrix::fits(dict)) cache.setPatternMatrix(std::make_shared<const PatternMatrix>(PatternMatrix::build(dict)));
+        seedOpenerRankings(dict, cache);
+    }
+
+    // Queues the reply line for one request; blank lines get none
+    void handle(const std::string& line) {
+        std::istringstream fields(line);
+        std::string id;
+        if (!(fields >> id)) return;
+        size_t slot = replies.reserve();
+        std::ostringstream out;
+        if (respond(id, fields, slot, out)) replies.fill(slot, out.str());
+    }
+
+    // Waits for the ranked hints still running
+    void finish() {
+        workers.reset();
+    }
+
+private:
+    // Writes the reply for a request to out; false if a worker fills slot instead
+    bool respond(const std::string& id, std::istringstream& fields, size_t slot, std::ostream& out) {
+        std::string command;
+        out << id << ' ';
+        if (!(fields >> command)) return fail(out, "missing command");
+        std::vector<std::string> args;
+        for (std::string arg; fields >> arg;) args.push_back(arg);
+
+        if (command == "NEW") {
+            if (!args.empty()) return fail(out, "NEW takes no arguments");
+            Session& session = sessions[id];
+            session.constraints = SolverConstraints();
+            session.candidates = dict.allAnswers();
+            out << "OK " << session.candidates.count() << '\n';
+            return true;
+        }
+        auto found = sessions.find(id);
+        if (found == sessions.end()) return fail(out, "unknown session, send NEW first");
+        Session& session = found->second;
+        if (command == "GUESS") return guess(session, args, out);
+        if (command == "HINT") return hint(id, session, args, slot, out);
+        if (command == "CANDIDATES") return listCandidates(session, args, out);
+        if (command == "END") {
+            if (!args.empty()) return fail(out, "END takes no arguments");
+            sessions.erase(found);
+            out << "OK\n";
+            return true;
+        }
+        return fail(out, "unknown command " + command);
+    }
+
+    static bool fail(std::ostream& out, const std::string& reason) {
+        out << "ERR " << reason << '\n';
+        return true;
+    }
+
+    bool guess(Session& session, const std::vector<std::string>& args, std::ostream& out) {
+        if (args.size() != 2) return fail(out, "GUESS takes a word and its feedback");
+        int word = dict.indexOf(upperCased(args[0]));
+        if (word < 0) return fail(out, "not in the word list: " + args[0]);
+        int pattern = patternFromString(upperCased(args[1]));
+        if (pattern < 0) return fail(out, "feedback must be five of G, Y and X: " + args[1]);
+        addFeedback(session.constraints, dict.packed[word], static_cast<uint8_t>(pattern));
+        session.candidates = filterByFeedback(dict, session.candidates, word, static_cast<uint8_t>(pattern));
+        out << "OK " << session.candidates.count() << '\n';
+        return true;
+    }
+
+    void writeGuesses(const std::vector<int>& best, std::ostream& out) const {
+        out << "OK";
+        for (int word : best) out << ' ' << dict.words[word];
+        out << '\n';
+    }
+
+    // The heuristic list takes well under a millisecond and is answered in place
+    bool hint(const std::string& id, const Session& session, const std::vector<std::string>& args, size_t slot, std::ostream& out) {
+        int count = 0;
+        if (args.empty() || args.size() > 2 || !parseCount(args[0], count)) return fail(out, "HINT takes a positive count and an optional mode");
+        RankingMode mode = RankingMode::Heuristic;
+        if (args.size() == 2 && !rankingModeFromName(args[1], mode)) return fail(out, "unknown mode " + args[1]);
+        if (mode == RankingMode::Heuristic || session.candidates.empty()) {
+            writeGuesses(mode == RankingMode::Heuristic ? scorer.topGuesses(session.constraints, count) : std::vector<int>(), out);
+            return true;
+        }
+        workers->submit([this, id, candidates = session.candidates, mode, count, slot]() {
+            std::vector<int> best;
+            for (const GuessMetrics& metrics : cachedRankGuesses(dict, candidates, mode, count, cache).page(0, count)) {
+                best.push_back(metrics.guess);
+            }
+            std::ostringstream reply;
+            reply << id << ' ';
+            writeGuesses(best, reply);
+            replies.fill(slot, reply.str());
+        });
+        return false;
+    }
+
+    bool listCandidates(const Session& session, const std::vector<std::string>& args, std::ostream& out) {
+        int limit = session.candidates.count();
+        if (args.size() > 1 || (args.size() == 1 && !parseCount(args[0], limit))) return fail(out, "CANDIDATES takes an optional positive limit");
+        out << "OK " << session.candidates.count();
+        int shown = 0;
+        session.candidates.forEach([&](int word) {
+            if (shown++ < limit) out << ' ' << dict.words[word];
+        });
+        out << '\n';
+        return true;
+    }
+
+    const HeuristicScorer& scorer;
+    const SolverDictionary& dict;
+    OrderedReplies& replies;
+    std::unordered_map<std::string, Session> sessions;
+    SolverCache cache; // positions repeat across sessions, most of all the opening
+    std::unique_ptr<HintWorkers> workers = std::make_unique<HintWorkers>(); // last: joined before the rest goes
+};
+
+} // namespace
+
+int runSolverProtocol(const HeuristicScorer& scorer, std::istream& in, std::ostream& out) {
+    OrderedReplies replies(out);
+    ProtocolServer server(scorer, replies);
+    std::string line;
+    while (std::getline(in, line)) server.handle(line);
+    server.finish();
+    replies.finish();
+    return 0;
+}
@@ -0,0 +1,25 @@
+#ifndef SOLVERPROTOCOL_H
+#define SOLVERPROTOCOL_H
+
+#include "HeuristicScoring.h"
+#include <iosfwd>
+
+// Line protocol for driving the solver from another process. Every request is one
+// line, "<session> <COMMAND> [arguments]", and gets exactly one reply line in request
+// order, "<session> OK ..." or "<session> ERR <reason>". Sessions are independent and
+// may be interleaved freely:
+//   NEW                     start (or restart) a session        -> OK <answers left>
+//   GUESS <word> <feedback> record a row, feedback as GYX       -> OK <answers left>
+//   HINT <k> [mode]         best k guesses, heuristic (the solver window's list) by
+//                           default or entropy, minimax, expected-size, lookahead
+//                                                               -> OK <word>...
+//   CANDIDATES [limit]      answers still possible              -> OK <count> <word>...
+//   END                     forget the session                  -> OK
+// Ranked hints (any mode but the heuristic) are computed on worker threads against the
+// session as it stood when the HINT was read. A slow lookahead hint therefore holds up
+// neither the reading of later requests nor other sessions' hints; their replies are
+// still written in request order, as soon as every reply before them is. Replies that
+// are ready together go out in one write.
+int runSolverProtocol(const HeuristicScorer& scorer, std::istream& in, std::ostream& out);
+
+#endif // SOLVERPROTOCOL_H
@@ -0,0 +1,136 @@
+#include "SolverQuery.h"
+
+namespace {
+
+// Alphabet letters of a token; false (with error set) on a symbol outside the alphabet
+bool lettersOf(const SolverAlphabet& alphabet, const std::u32string& symbols, std::vector<int>& letters, std::string& error) {
+    letters.clear();
+    for (char32_t symbol : symbols) {
+        int letter = alphabet.indexOf(foldToUpper(symbol));
+        if (letter < 0) {
+            error.clear();
+            appendUtf8(error, symbol);
+            error += " is not a letter of this word list";
+            return false;
+        }
+        letters.push_back(letter);
+    }
+    return true;
+}
+
+bool parseCount(const std::u32string& symbols, size_t begin, size_t end, int& count) {
+    if (begin >= end || end - begin > 1 || symbols[begin] < U'0' || symbols[begin] > U'0' + WORD_LENGTH) return false;
+    count = static_cast<int>(symbols[begin] - U'0');
+    return true;
+}
+
+// "L=N", "L=MIN-MAX" or "L=MIN-"
+bool parseCountRange(const std::u32string& token, int& low, int& high) {
+    size_t dash = token.find(U'-', 2);
+    if (dash == std::u32string::npos) {
+        if (!parseCount(token, 2, token.size(), low)) return false;
+        high = low;
+        return true;
+    }
+    if (!parseCount(token, 2, dash, low)) return false;
+    if (dash + 1 == token.size()) {
+        high = WORD_LENGTH;
+        return true;
+    }
+    return parseCount(token, dash + 1, token.size(), high) && low <= high;
+}
+
+} // namespace
+
+bool parseWordQuery(const SolverAlphabet& alphabet, const std::string& text, WordQuery& query, std::string& error) {
+    query = WordQuery();
+    std::u32string symbols;
+    if (!decodeUtf8(text.data(), text.data() + text.size(), symbols)) {
+        error = "Query is not valid UTF-8";
+        return false;
+    }
+    bool sawPattern = false;
+    std::vector<int> letters;
+    size_t pos = 0;
+    while (pos < symbols.size()) {
+        if (symbols[pos] == U' ' || symbols[pos] == U'\t') {
+            ++pos;
+            continue;
+        }
+        size_t end = symbols.find_first_of(U" \t", pos);
+        if (end == std::u32string::npos) end = symbols.size();
+        std::u32string token = symbols.substr(pos, end - pos);
+        std::string tokenText;
+        for (char32_t symbol : token) appendUtf8(tokenText, symbol);
+        pos = end;
+
+        if (token[0] == U'+' || token[0] == U'-') {
+            if (token.size() == 1) {
+                error = "Expected letters after " + tokenText;
+                return false;
+            }
+            if (!lettersOf(alphabet, token.substr(1), letters, error)) return false;
+            for (int letter : letters) {
+                if (token[0] == U'+') query.minCount[letter] = std::max<uint8_t>(query.minCount[letter], 1);
+                else query.maxCount[letter] = 0;
+            }
+        } else if (token.size() > 1 && token[1] == U'=') {
+            int low = 0, high = 0;
+            if (!lettersOf(alphabet, token.substr(0, 1), letters, error)) return false;
+            if (!parseCountRange(token, low, high)) {
+                error = "Bad letter count " + tokenText + ", expected e.g. E=2, E=1-2 or E=2-";
+                return false;
+            }
+            query.minCount[letters[0]] = std::max<uint8_t>(query.minCount[letters[0]], static_cast<uint8_t>(low));
+            query.maxCount[letters[0]] = std::min<uint8_t>(query.maxCount[letters[0]], static_cast<uint8_t>(high));
+        } else {
+            if (sawPattern || token.size() != WORD_LENGTH) {
+                error = "Unexpected " + tokenText + "; the pattern is one " + std::to_string(WORD_LENGTH) + "-symbol token like ?R?N?";
+                return false;
+            }
+            sawPattern = true;
+            for (int i = 0; i < WORD_LENGTH; ++i) {
+                if (token[i] == U'?' || token[i] == U'.') continue;
+                if (!lettersOf(alphabet, token.substr(i, 1), letters, error)) return false;
+                query.fixed[i] = letters[0];
+            }
+        }
+    }
+    return true;
+}
+
+WordIndex WordIndex::build(const SolverDictionary& dict) {
+    WordIndex index;
+    size_t postings = static_cast<size_t>(dict.alphabet.size()) * WORD_LENGTH;
+    index.positional.assign(postings, CandidateSet(dict.size()));
+    index.counted.assign(postings, CandidateSet(dict.size()));
+    for (int word = 0; word < dict.size(); ++word) {
+        uint8_t copies[MAX_ALPHABET_SIZE] = {};
+        for (int i = 0; i < WORD_LENGTH; ++i) {
+            int letter = dict.packed[word][i];
+            index.positional[letter * WORD_LENGTH + i].insert(word);
+            index.counted[letter * WORD_LENGTH + copies[letter]++].insert(word);
+        }
+    }
+    return index;
+}
+
+CandidateSet WordIndex::match(const WordQuery& query, const CandidateSet& scope) const {
+    CandidateSet result = scope;
+    // Letters pinned to positions count toward their minimum
+    std::array<uint8_t, MAX_ALPHABET_SIZE> pinned{};
+    for (int i = 0; i < WORD_LENGTH; ++i) {
+        if (query.fixed[i] < 0) continue;
+        result &= at(query.fixed[i], i);
+        ++pinned[query.fixed[i]];
+    }
+    int letters = static_cast<int>(positional.size() / WORD_LENGTH);
+    for (int letter = 0; letter < letters; ++letter) {
+        int low = std::max(query.minCount[letter], pinned[letter]);
+        int high = query.maxCount[letter];
+        if (low > high) return CandidateSet(scope.universe());
+        if (low > 0 && low > pinned[letter]) result &= atLeast(letter, low);
+        if (high < WORD_LENGTH) result.andNot(atLeast(letter, high + 1));
+    }
+    return result;
+}
@@ -0,0 +1,46 @@
+#ifndef SOLVERQUERY_H
+#define SOLVERQUERY_H
+
+#include "SolverCore.h"
+#include <string>
+
+// Ad-hoc dictionary queries, e.g. "?R?N? +E -ST A=0-1". Tokens, space separated:
+//   ?R?N?     one symbol per position: a letter that must be there, or ? (or .) for any
+//   +LETTERS  each letter appears at least once
+//   -LETTERS  none of the letters appear
+//   L=N       letter L appears exactly N times; L=MIN-MAX for a range, L=MIN- for at least
+// Letters are case-insensitive and must belong to the dictionary's alphabet.
+struct WordQuery {
+    std::array<int, WORD_LENGTH> fixed; // alphabet letter per position, -1 for any
+    std::array<uint8_t, MAX_ALPHABET_SIZE> minCount;
+    std::array<uint8_t, MAX_ALPHABET_SIZE> maxCount;
+
+    WordQuery() {
+        fixed.fill(-1);
+        minCount.fill(0);
+        maxCount.fill(WORD_LENGTH);
+    }
+};
+
+bool parseWordQuery(const SolverAlphabet& alphabet, const std::string& text, WordQuery& query, std::string& error);
+
+// Posting bitsets over the dictionary: the words holding a letter at a position and
+// the words holding at least n copies of a letter. Built once after loading; a query
+// is then a few ANDs of dictionary-wide bitsets.
+class WordIndex {
+public:
+    WordIndex() = default;
+    static WordIndex build(const SolverDictionary& dict);
+
+    const CandidateSet& at(int letter, int position) const { return positional[letter * WORD_LENGTH + position]; }
+    const CandidateSet& atLeast(int letter, int copies) const { return counted[letter * WORD_LENGTH + copies - 1]; } // copies 1..WORD_LENGTH
+
+    // Members of scope matching query
+    CandidateSet match(const WordQuery& query, const CandidateSet& scope) const;
+
+private:
+    std::vector<CandidateSet> positional; // letter * WORD_LENGTH + position
+    std::vector<CandidateSet> counted;    // letter * WORD_LENGTH + copies - 1
+};
+
+#endif // SOLVERQUERY_H
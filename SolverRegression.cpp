@@ -0,0 +1,263 @@
+#include "SolverRegression.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+
+// ============================================================================
+// Strategies
+// ============================================================================
+
+namespace {
+
+const RankingMode RANKED_STRATEGIES[] = {RankingMode::Entropy, RankingMode::Minimax, RankingMode::ExpectedSize, RankingMode::Lookahead};
+
+struct CandidateSetHash {
+    size_t operator()(const CandidateSet& candidates) const { return static_cast<size_t>(candidates.hash()); }
+};
+
+double percentile99(std::vector<double> samples) {
+    if (samples.empty()) return 0.0;
+    size_t rank = (samples.size() * 99 + 99) / 100 - 1;
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    return samples[rank];
+}
+
+// Every game reaches the same states over and over; each is ranked once and timed once
+class RankedPlayer {
+public:
+    RankedPlayer(const SolverDictionary& dict, RankingMode mode) : dict(dict), mode(mode) {}
+
+    int play(int answer) {
+        CandidateSet candidates = dict.allAnswers();
+        for (int turn = 1; turn <= MAX_GUESSES; ++turn) {
+            int guess = choose(candidates);
+            if (guess < 0) break;
+            if (guess == answer) return turn;
+            candidates = filterByFeedback(dict, candidates, guess, computeFeedback(dict.packed[guess], dict.packed[answer]));
+        }
+        return MAX_GUESSES + 1;
+    }
+
+    const std::vector<double>& moveSeconds() const { return seconds; }
+
+private:
+    int choose(const CandidateSet& candidates) {
+        auto known = choices.find(candidates);
+        if (known != choices.end()) return known->second;
+        auto start = std::chrono::steady_clock::now();
+        CandidateList list = candidates.toList();
+        std::vector<GuessMetrics> best = rankGuesses(dict, list, mode, 1).page(0, 1);
+        int guess = best.empty() ? -1 : best.front().guess;
+        seconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        choices.emplace(candidates, guess);
+        return guess;
+    }
+
+    const SolverDictionary& dict;
+    RankingMode mode;
+    std::unordered_map<CandidateSet, int, CandidateSetHash> choices;
+    std::vector<double> seconds;
+};
+
+// The game window's hint (heuristicHint): the starting-word list's opener, then the
+// heuristic scored by frequencies over every word. Rows fold in as constraintsFromRows
+// reads them, graying a letter unless the same row shows it green or yellow, and a
+// hint already played is not skipped.
+int playGameHintGame(const HeuristicScorer& opening, const HeuristicScorer& hints, int answer, std::vector<double>& moveSeconds) {
+    const SolverDictionary& dict = hints.dictionary();
+    SolverConstraints constraints;
+    for (int turn = 1; turn <= MAX_GUESSES; ++turn) {
+        auto start = std::chrono::steady_clock::now();
+        int guess = turn == 1 ? opening.bestGuess(constraints) : hints.bestGuess(constraints);
+        moveSeconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        if (guess < 0) break;
+        if (guess == answer) return turn;
+        const PackedWord& word = dict.packed[guess];
+        uint8_t pattern = computeFeedback(word, dict.packed[answer]);
+        LetterMask shown = 0, gray = 0;
+        int digits = pattern;
+        for (int i = 0; i < WORD_LENGTH; ++i, digits /= 3) {
+            LetterMask bit = LetterMask(1) << word[i];
+            if (digits % 3 == 2) {
+                constraints.green[i] = word[i];
+                shown |= bit;
+            } else if (digits % 3 == 1) {
+                constraints.yellowForbidden[i] |= bit;
+                constraints.yellowLetters |= bit;
+                shown |= bit;
+            } else {
+                gray |= bit;
+            }
+        }
+        constraints.grayLetters |= gray & ~shown;
+    }
+    return MAX_GUESSES + 1;
+}
+
+// One pass over every answer; moveSeconds gets the time of each decision computed
+bool playAllAnswers(const SolverDictionary& dict, const std::string& strategy, GameTally& tally, std::vector<double>& moveSeconds) {
+    if (strategy == "heuristic") {
+        HeuristicScorer scorer(dict, defaultScoringProfile());
+        for (int answer = 0; answer < dict.answerCount; ++answer) tally.add(playHeuristicGame(scorer, answer, &moveSeconds));
+    } else if (strategy == "game-hint") {
+        HeuristicScorer opening(dict, defaultScoringProfile());
+        HeuristicScorer hints(dict, defaultScoringProfile(), FrequencySource::AllWords);
+        for (int answer = 0; answer < dict.answerCount; ++answer) tally.add(playGameHintGame(opening, hints, answer, moveSeconds));
+    } else {
+        RankingMode mode;
+        if (!rankingModeFromName(strategy, mode)) return false;
+        RankedPlayer player(dict, mode);
+        for (int answer = 0; answer < dict.answerCount; ++answer) tally.add(player.play(answer));
+        moveSeconds = player.moveSeconds();
+    }
+    return true;
+}
+
+} // namespace
+
+const std::vector<std::string>& regressionStrategies() {
+    static const std::vector<std::string> names = [] {
+        std::vector<std::string> list = {"heuristic", "game-hint"};
+        for (RankingMode mode : RANKED_STRATEGIES) list.push_back(rankingModeName(mode));
+        return list;
+    }();
+    return names;
+}
+
+double calibrationMs(const SolverDictionary& dict) {
+    const size_t CALIBRATION_ANSWERS = 256;
+    const int RUNS = 5;
+    CandidateList answers = dict.allAnswers().toList();
+    answers.resize(std::min(answers.size(), CALIBRATION_ANSWERS));
+    double best = std::numeric_limits<double>::infinity();
+    for (int run = 0; run < RUNS; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        rankGuesses(dict, answers, RankingMode::Entropy, 1);
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1000.0);
+    }
+    return best;
+}
+
+bool playStrategy(const SolverDictionary& dict, const std::string& strategy, StrategyReport& report) {
+    // One pass's p99 swings by a third with whatever else the host is doing; the median
+    // of a few passes, each against its own calibration, holds to a tight tolerance
+    const int LATENCY_RUNS = 3;
+    std::vector<StrategyReport> runs(LATENCY_RUNS);
+    for (StrategyReport& run : runs) {
+        run.strategy = strategy;
+        run.calibrationMs = calibrationMs(dict);
+        std::vector<double> moveSeconds;
+        if (!playAllAnswers(dict, strategy, run.tally, moveSeconds)) return false;
+        run.movesTimed = static_cast<int>(moveSeconds.size());
+        run.p99MoveMs = percentile99(std::move(moveSeconds)) * 1000.0;
+    }
+    std::nth_element(runs.begin(), runs.begin() + LATENCY_RUNS / 2, runs.end(),
+                     [](const StrategyReport& a, const StrategyReport& b) { return a.p99Relative() < b.p99Relative(); });
+    report = runs[LATENCY_RUNS / 2];
+    return true;
+}
+
+// ============================================================================
+// Baseline
+// ============================================================================
+
+void RegressionBaseline::record(const StrategyReport& report) {
+    BaselineEntry entry{report.strategy, report.tally.meanGuesses(), report.failureRate(), report.p99Relative()};
+    for (BaselineEntry& existing : entries) {
+        if (existing.strategy == report.strategy) {
+            existing = entry;
+            return;
+        }
+    }
+    entries.push_back(entry);
+}
+
+bool loadRegressionBaseline(const std::string& path, RegressionBaseline& baseline, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "Cannot open " + path;
+        return false;
+    }
+    RegressionBaseline loaded;
+    std::string line;
+    for (int lineNumber = 1; std::getline(in, line); ++lineNumber) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string name, extra;
+        if (!(fields >> name)) continue;
+        bool ok;
+        if (name == "tolerance") {
+            std::string setting;
+            double value;
+            ok = static_cast<bool>(fields >> setting >> value);
+            if (setting == "mean-guesses") loaded.tolerance.meanGuesses = value;
+            else if (setting == "failure-rate") loaded.tolerance.failureRate = value;
+            else if (setting == "latency-ratio") loaded.tolerance.latencyRatio = value;
+            else if (setting == "latency-slack") loaded.tolerance.latencySlack = value;
+            else ok = false;
+        } else {
+            BaselineEntry entry;
+            entry.strategy = name;
+            ok = static_cast<bool>(fields >> entry.meanGuesses >> entry.failureRate >> entry.p99Relative);
+            loaded.entries.push_back(entry);
+        }
+        if (!ok || fields >> extra) {
+            error = path + ":" + std::to_string(lineNumber) + ": cannot read \"" + line + "\"";
+            return false;
+        }
+    }
+    baseline = loaded;
+    return true;
+}
+
+bool saveRegressionBaseline(const std::string& path, const RegressionBaseline& baseline, std::string& error) {
+    std::ofstream out(path);
+    const RegressionTolerance& tolerance = baseline.tolerance;
+    out << "# Solver regression baseline, written by: Wordle_Calculator_Headless regression-report --write-baseline\n"
+        << "tolerance mean-guesses " << tolerance.meanGuesses << "\n"
+        << "tolerance failure-rate " << tolerance.failureRate << "\n"
+        << "tolerance latency-ratio " << tolerance.latencyRatio << "\n"
+        << "tolerance latency-slack " << tolerance.latencySlack << "\n"
+        << "# strategy  mean-guesses  failure-rate  p99-move (in calibration runs)\n";
+    char row[160];
+    for (const BaselineEntry& entry : baseline.entries) {
+        std::snprintf(row, sizeof(row), "%s %.4f %.5f %.4f\n", entry.strategy.c_str(), entry.meanGuesses,
+                      entry.failureRate, entry.p99Relative);
+        out << row;
+    }
+    if (!out.flush()) {
+        error = "Cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+std::vector<std::string> compareToBaseline(const StrategyReport& report, const RegressionBaseline& baseline) {
+    std::vector<std::string> regressions;
+    const RegressionTolerance& tolerance = baseline.tolerance;
+    char message[200];
+    for (const BaselineEntry& entry : baseline.entries) {
+        if (entry.strategy != report.strategy) continue;
+        if (report.tally.meanGuesses() > entry.meanGuesses + tolerance.meanGuesses) {
+            std::snprintf(message, sizeof(message), "%s: mean guesses %.4f, baseline %.4f", report.strategy.c_str(),
+                          report.tally.meanGuesses(), entry.meanGuesses);
+            regressions.push_back(message);
+        }
+        if (report.failureRate() > entry.failureRate + tolerance.failureRate) {
+            std::snprintf(message, sizeof(message), "%s: failure rate %.5f, baseline %.5f", report.strategy.c_str(),
+                          report.failureRate(), entry.failureRate);
+            regressions.push_back(message);
+        }
+        double latencyLimit = entry.p99Relative * tolerance.latencyRatio + tolerance.latencySlack;
+        if (report.p99Relative() > latencyLimit) {
+            std::snprintf(message, sizeof(message), "%s: p99 move %.4f calibration runs (%.3f ms), limit %.4f (baseline %.4f)",
+                          report.strategy.c_str(), report.p99Relative(), report.p99MoveMs, latencyLimit, entry.p99Relative);
+            regressions.push_back(message);
+        }
+    }
+    return regressions;
+}
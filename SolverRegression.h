@@ -0,0 +1,69 @@
+#ifndef SOLVERREGRESSION_H
+#define SOLVERREGRESSION_H
+
+#include "HeuristicScoring.h"
+#include <string>
+#include <vector>
+
+// Quality and latency of each solving strategy over every answer, checked against a
+// baseline file so faster engines can be swapped in without silently changing play.
+// "heuristic" is the solver window's heuristic list (frequencies over the answers),
+// "game-hint" the game window's hint (frequencies over every word); the others are
+// the solver window's rankings, each playing its top guess.
+struct StrategyReport {
+    std::string strategy;
+    GameTally tally;
+    double p99MoveMs = 0.0; // per decision actually computed, median of a few passes; repeated states are reused
+    int movesTimed = 0;
+    double calibrationMs = 0.0; // calibrationMs() measured alongside
+
+    double failureRate() const { return tally.played() ? static_cast<double>(tally.losses()) / tally.played() : 0.0; }
+    // Latency in units of the calibration workload, comparable across machines
+    double p99Relative() const { return calibrationMs > 0.0 ? p99MoveMs / calibrationMs : 0.0; }
+};
+
+// Milliseconds this machine takes for a fixed ranking job (entropy over the first
+// 256 answers, on every core; best of five). Baselines keep latency relative to it, so
+// a slower host or a sanitizer build moves both sides alike.
+double calibrationMs(const SolverDictionary& dict);
+
+// Names accepted by playStrategy, in report order
+const std::vector<std::string>& regressionStrategies();
+
+// false if strategy is not one of regressionStrategies()
+bool playStrategy(const SolverDictionary& dict, const std::string& strategy, StrategyReport& report);
+
+// How far a report may drift from the baseline before it counts as a regression
+struct RegressionTolerance {
+    double meanGuesses = 0.01;   // absolute increase
+    double failureRate = 0.001;  // absolute increase
+    double latencyRatio = 1.75;  // relative p99 may grow to baseline * ratio + latencySlack
+    double latencySlack = 0.02;  // in calibration units, for moves too quick to time steadily
+};
+
+// Baseline files hold "tolerance <name> <value>" lines and one
+// "<strategy> <mean guesses> <failure rate> <relative p99>" line per strategy; # starts
+// a comment
+struct BaselineEntry {
+    std::string strategy;
+    double meanGuesses = 0.0;
+    double failureRate = 0.0;
+    double p99Relative = 0.0;
+};
+
+struct RegressionBaseline {
+    RegressionTolerance tolerance;
+    std::vector<BaselineEntry> entries;
+
+    // Replaces or adds the entry for report's strategy
+    void record(const StrategyReport& report);
+};
+
+bool loadRegressionBaseline(const std::string& path, RegressionBaseline& baseline, std::string& error);
+bool saveRegressionBaseline(const std::string& path, const RegressionBaseline& baseline, std::string& error);
+
+// One message per regression; empty when report is within tolerance. A strategy
+// missing from the baseline is not a regression.
+std::vector<std::string> compareToBaseline(const StrategyReport& report, const RegressionBaseline& baseline);
+
+#endif // SOLVERREGRESSION_H
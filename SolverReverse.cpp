@@ -0,0 +1,170 @@
+#include "SolverReverse.h"
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+
+// Digit for a tile symbol, -1 for anything else
+int tileDigit(char32_t symbol) {
+    switch (symbol) {
+    case U'\U0001F7E9': case U'\U0001F7E7': case U'G': case U'g': return 2; // 🟩 🟧
+    case U'\U0001F7E8': case U'\U0001F7E6': case U'Y': case U'y': return 1; // 🟨 🟦
+    case U'\u2B1B': case U'\u2B1C': case U'X': case U'x': return 0;           // ⬛ ⬜
+    default: return -1;
+    }
+}
+
+double fallingFactorial(int n, int k) {
+    double product = 1.0;
+    for (int i = 0; i < k; ++i) product *= std::max(0, n - i);
+    return product;
+}
+
+// Depth-first count of consistent sequences. allowed holds the words that agree with
+// every row so far, trimmed to those some later row could use; a row's options are
+// its bucket within allowed. Positions recur under different earlier words, so
+// counts are memoized per (row, allowed).
+class ConsistentCounter {
+public:
+    ConsistentCounter(const SolverDictionary& dict, const ReverseIndex& index, const std::vector<uint8_t>& patterns,
+                      const std::vector<CandidateSet>& usable, std::atomic<long long>& visited, long long budget)
+        : dict(dict), index(index), patterns(patterns), usable(usable), visited(visited), budget(budget), memo(patterns.size()) {}
+
+    // false once the shared budget runs out
+    bool count(size_t row, const CandidateSet& allowed, double& total) {
+        CandidateSet options = index.guessesFor(patterns[row]) & allowed;
+        if (row + 1 == patterns.size()) {
+            total = options.count();
+            return true;
+        }
+        if (row + 2 == patterns.size()) {
+            // Last row (usually just the answer): test its few words directly
+            CandidateList last = (index.guessesFor(patterns[row + 1]) & allowed).toList();
+            total = 0.0;
+            options.forEach([&](int guess) {
+                for (int word : last) total += computeFeedback(dict.packed[guess], dict.packed[word]) == patterns[row];
+            });
+            return true;
+        }
+        uint64_t key = allowed.hash();
+        auto found = memo[row].find(key);
+        if (found != memo[row].end() && found->second.first == allowed) {
+            total = found->second.second;
+            return true;
+        }
+        total = 0.0;
+        bool withinBudget = true;
+        options.forEach([&](int guess) {
+            if (!withinBudget) return;
+            if (visited.fetch_add(1, std::memory_order_relaxed) >= budget) {
+                withinBudget = false;
+                return;
+            }
+            double below = 0.0;
+            withinBudget = count(row + 1, filterByFeedback(dict, allowed & usable[row + 1], guess, patterns[row]), below);
+            total += below;
+        });
+        if (withinBudget) memo[row][key] = {allowed, total};
+        return withinBudget;
+    }
+
+private:
+    const SolverDictionary& dict;
+    const ReverseIndex& index;
+    const std::vector<uint8_t>& patterns;
+    const std::vector<CandidateSet>& usable; // by row: words in its bucket or a later row's
+    std::atomic<long long>& visited;
+    long long budget;
+    std::vector<std::unordered_map<uint64_t, std::pair<CandidateSet, double>>> memo; // by row
+};
+
+} // namespace
+
+bool parseShareGrid(const std::string& text, std::vector<uint8_t>& patterns, std::string& error) {
+    patterns.clear();
+    std::istringstream lines(text);
+    for (std::string line; std::getline(lines, line);) {
+        std::u32string symbols;
+        if (!decodeUtf8(line.data(), line.data() + line.size(), symbols)) {
+            error = "Grid is not valid UTF-8";
+            return false;
+        }
+        int pattern = 0, tiles = 0, weight = 1;
+        bool tileRow = true;
+        for (char32_t symbol : symbols) {
+            if (symbol == U' ' || symbol == U'\t' || symbol == U'\r' || symbol == U'\uFE0F') continue; // FE0F: emoji presentation selector
+            int digit = tileDigit(symbol);
+            if (digit < 0 || tiles == WORD_LENGTH) {
+                tileRow = false;
+                break;
+            }
+            pattern += digit * weight;
+            weight *= 3;
+            ++tiles;
+        }
+        if (tileRow && tiles == WORD_LENGTH) patterns.push_back(static_cast<uint8_t>(pattern));
+    }
+    if (patterns.empty()) {
+        error = "No rows of five tiles in the grid";
+        return false;
+    }
+    return true;
+}
+
+ReverseIndex ReverseIndex::build(const SolverDictionary& dict, int answer) {
+    ReverseIndex index;
+    index.target = answer;
+    std::vector<uint8_t> patterns(dict.size());
+    parallelFor(dict.size(), [&](int begin, int end) {
+        for (int guess = begin; guess < end; ++guess) patterns[guess] = computeFeedback(dict.packed[guess], dict.packed[answer]);
+    });
+    index.buckets.assign(PATTERN_COUNT, CandidateSet(dict.size()));
+    for (int guess = 0; guess < dict.size(); ++guess) index.buckets[patterns[guess]].insert(guess);
+    return index;
+}
+
+ReverseSolution reverseSolve(const SolverDictionary& dict, const ReverseIndex& index, const std::vector<uint8_t>& patterns,
+                             long long consistentBudget) {
+    ReverseSolution solution;
+    std::array<int, PATTERN_COUNT> rowsWithPattern{};
+    for (uint8_t pattern : patterns) {
+        solution.rowGuesses.push_back(index.guessesFor(pattern));
+        ++rowsWithPattern[pattern];
+    }
+    // A word gets one pattern, so only rows sharing colors compete for the same words
+    solution.sequences = patterns.empty() ? 0.0 : 1.0;
+    for (int pattern = 0; pattern < PATTERN_COUNT; ++pattern) {
+        if (rowsWithPattern[pattern] > 0) solution.sequences *= fallingFactorial(index.guessesFor(pattern).count(), rowsWithPattern[pattern]);
+    }
+    if (consistentBudget <= 0 || patterns.empty()) return solution;
+
+    // Split across cores by the first row's word, each core with its own memo
+    CandidateList first = index.guessesFor(patterns[0]).toList();
+    std::vector<CandidateSet> usable(patterns.size() + 1, CandidateSet(dict.size()));
+    for (size_t row = patterns.size(); row-- > 0;) usable[row] = usable[row + 1] | index.guessesFor(patterns[row]);
+    std::atomic<long long> visited{0};
+    std::mutex totalMutex;
+    double total = 0.0;
+    bool withinBudget = true;
+    if (patterns.size() == 1) {
+        total = static_cast<double>(first.size());
+    } else {
+        parallelFor(static_cast<int>(first.size()), [&](int begin, int end) {
+            ConsistentCounter counter(dict, index, patterns, usable, visited, consistentBudget);
+            double part = 0.0;
+            bool ok = true;
+            for (int i = begin; i < end && ok; ++i) {
+                double below = 0.0;
+                ok = counter.count(1, filterByFeedback(dict, usable[1], first[i], patterns[0]), below);
+                part += below;
+            }
+            std::lock_guard<std::mutex> lock(totalMutex);
+            total += part;
+            withinBudget = withinBudget && ok;
+        });
+    }
+    if (withinBudget) solution.consistentSequences = total;
+    return solution;
+}
@@ -0,0 +1,46 @@
+#ifndef SOLVERREVERSE_H
+#define SOLVERREVERSE_H
+
+#include "SolverCore.h"
+#include <string>
+#include <vector>
+
+// Working back from a shared result grid: which words could have been played on each
+// row given the answer. Feedback follows computeFeedback, i.e. the game window's
+// generateFeedback.
+
+// Tile rows from a pasted grid: 🟩 green, 🟨 yellow, ⬛/⬜ gray (🟧/🟦 for the
+// high-contrast green/yellow), or G/Y/X. Lines that are not five tiles, such as the
+// "Wordle 1,234 4/6" header, are skipped.
+bool parseShareGrid(const std::string& text, std::vector<uint8_t>& patterns, std::string& error);
+
+// The (answer, pattern) -> guesses slice of the inverted feedback index for one answer:
+// every dictionary word bucketed by the colors it gets against that answer. About
+// 400 KB and a fraction of a millisecond to build, so it is built per answer looked
+// up instead of for every answer up front (that would be some 60 MB).
+class ReverseIndex {
+public:
+    static ReverseIndex build(const SolverDictionary& dict, int answer);
+
+    int answer() const { return target; }
+    const CandidateSet& guessesFor(uint8_t pattern) const { return buckets[pattern]; }
+
+private:
+    int target = -1;
+    std::vector<CandidateSet> buckets; // by pattern
+};
+
+struct ReverseSolution {
+    std::vector<CandidateSet> rowGuesses; // words giving each row's colors
+    // Sequences of distinct words, one per row, that give the grid
+    double sequences = 0.0;
+    // Of those, the ones where every word agrees with the rows before it, i.e. could
+    // still have been the answer when played; -1 if not counted or over the budget
+    double consistentSequences = -1.0;
+};
+
+// consistentBudget caps the search states visited for consistentSequences; 0 skips it
+ReverseSolution reverseSolve(const SolverDictionary& dict, const ReverseIndex& index, const std::vector<uint8_t>& patterns,
+                             long long consistentBudget);
+
+#endif // SOLVERREVERSE_H
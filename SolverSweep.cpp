@@ -0,0 +1,461 @@
+#include "SolverSweep.h"
+#include "DictionaryLoader.h"
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// Shards and checkpoints
+// ============================================================================
+
+namespace {
+
+constexpr const char *CHECKPOINT_MAGIC = "wordle-sweep";
+constexpr int CHECKPOINT_VERSION = 1;
+
+struct ShardLayout {
+    int answerCount;
+    int shardSize;
+    int shardsPerProfile;
+    int shardCount;
+
+    ShardLayout(int answerCount, int shardSize, int profileCount)
+        : answerCount(answerCount), shardSize(shardSize),
+          shardsPerProfile((answerCount + shardSize - 1) / shardSize),
+          shardCount(shardsPerProfile * profileCount) {}
+
+    int profile(int shard) const { return shard / shardsPerProfile; }
+    int begin(int shard) const { return (shard % shardsPerProfile) * shardSize; }
+    int end(int shard) const { return std::min(answerCount, begin(shard) + shardSize); }
+};
+
+// Identifies the sweep a checkpoint belongs to: the word lists themselves, not just
+// their sizes, the game length and the work split
+uint64_t sweepFingerprint(const SolverDictionary& dict, const std::vector<ScoringProfile>& profiles, int shardSize) {
+    uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](int64_t value) {
+        hash ^= static_cast<uint64_t>(value);
+        hash *= 1099511628211ull;
+    };
+    mix(dict.size());
+    mix(dict.answerCount);
+    for (int i = 0; i < dict.alphabet.size(); ++i) mix(dict.alphabet.symbol(i));
+    for (const PackedWord& word : dict.packed) mix(packWordKey(word));
+    mix(MAX_GUESSES);
+    mix(shardSize);
+    for (const ScoringProfile& profile : profiles) {
+        mix(profile.uniqueLetterBonus);
+        mix(profile.yellowLetterBonus);
+        mix(profile.repeatPenalty);
+        mix(profile.yellowRepeatPenalty);
+    }
+    return hash;
+}
+
+// Keeps one scorer per worker, rebuilt only when a shard switches profile
+class ShardRunner {
+public:
+    ShardRunner(const SolverDictionary& dict, const std::vector<ScoringProfile>& profiles, const ShardLayout& layout)
+        : dict(dict), profiles(profiles), layout(layout) {}
+
+    GameTally run(int shard) {
+        int profile = layout.profile(shard);
+        if (!scorer || profile != scorerProfile) {
+            scorer = std::make_unique<HeuristicScorer>(dict, profiles[profile]);
+            scorerProfile = profile;
+        }
+        return playHeuristicGames(*scorer, layout.begin(shard), layout.end(shard));
+    }
+
+private:
+    const SolverDictionary& dict;
+    const std::vector<ScoringProfile>& profiles;
+    const ShardLayout& layout;
+    std::unique_ptr<HeuristicScorer> scorer;
+    int scorerProfile = -1;
+};
+
+// Completed shards, loaded from and appended to the checkpoint file
+class Checkpoint {
+public:
+    Checkpoint(int shardCount) : tallies(shardCount), done(shardCount, false) {}
+
+    bool open(const std::string& path, uint64_t fingerprint, std::string& error) {
+        if (path.empty()) return true;
+        std::string header = std::string(CHECKPOINT_MAGIC) + " " + std::to_string(CHECKPOINT_VERSION) + " "
+                             + std::to_string(fingerprint) + " " + std::to_string(tallies.size());
+        std::ifstream in(path);
+        std::string line;
+        bool resuming = in && std::getline(in, line);
+        if (resuming) {
+            if (line != header) {
+                error = path + " is a checkpoint for a different sweep";
+                return false;
+            }
+            while (std::getline(in, line)) {
+                // A line cut short by an interruption is simply redone
+                std::istringstream fields(line);
+                int shard;
+                GameTally tally;
+                if (!(fields >> shard) || shard < 0 || shard >= static_cast<int>(tallies.size())) continue;
+                bool complete = true;
+                for (int& games : tally.games) complete = complete && static_cast<bool>(fields >> games);
+                std::string extra;
+                if (!complete || fields >> extra) continue;
+                tallies[shard] = tally;
+                done[shard] = true;
+            }
+        }
+        // getline also stops at end of file, so check whether the last line was cut short
+        bool unterminated = false;
+        if (resuming) {
+            in.clear();
+            in.seekg(-1, std::ios::end);
+            unterminated = in.get() != '\n';
+        }
+        in.close();
+        file = std::fopen(path.c_str(), resuming ? "a" : "w");
+        if (!file) {
+            error = "Cannot write " + path;
+            return false;
+        }
+        if (unterminated) std::fputc('\n', file);
+        if (!resuming) {
+            std::fprintf(file, "%s\n", header.c_str());
+            std::fflush(file);
+        }
+        return true;
+    }
+
+    ~Checkpoint() {
+        if (file) std::fclose(file);
+    }
+
+    bool isDone(int shard) const { return done[shard]; }
+    int doneCount() const { return static_cast<int>(std::count(done.begin(), done.end(), true)); }
+    const GameTally& tally(int shard) const { return tallies[shard]; }
+
+    void record(int shard, const GameTally& tally) {
+        tallies[shard] = tally;
+        done[shard] = true;
+        if (!file) return;
+        std::fprintf(file, "%d", shard);
+        for (int games : tally.games) std::fprintf(file, " %d", games);
+        std::fprintf(file, "\n");
+        // One line per shard, flushed so an interruption loses at most the shards in flight
+        std::fflush(file);
+    }
+
+private:
+    std::vector<GameTally> tallies;
+    std::vector<bool> done;
+    std::FILE *file = nullptr;
+};
+
+// ============================================================================
+// Workers
+// ============================================================================
+
+void runInProcess(const SolverDictionary& dict, const std::vector<ScoringProfile>& profiles, const ShardLayout& layout,
+                  const std::vector<int>& pending, Checkpoint& checkpoint, const std::function<void()>& shardDone) {
+    std::mutex mutex;
+    parallelFor(static_cast<int>(pending.size()), [&](int begin, int end) {
+        ShardRunner runner(dict, profiles, layout);
+        for (int i = begin; i < end; ++i) {
+            GameTally tally = runner.run(pending[i]);
+            std::lock_guard<std::mutex> lock(mutex);
+            checkpoint.record(pending[i], tally);
+            shardDone();
+        }
+    });
+}
+
+#if !defined(_WIN32)
+
+// Fixed-size records, well under PIPE_BUF so each write is atomic
+struct ShardRequest {
+    int32_t shard; // -1 asks the worker to exit
+};
+
+struct ShardReport {
+    int32_t shard;
+    int32_t games[MAX_GUESSES + 2];
+};
+
+bool readFully(int fd, void *buffer, size_t size) {
+    char *out = static_cast<char *>(buffer);
+    while (size > 0) {
+        ssize_t got = read(fd, out, size);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        out += got;
+        size -= static_cast<size_t>(got);
+    }
+    return true;
+}
+
+bool writeFully(int fd, const void *buffer, size_t size) {
+    const char *in = static_cast<const char *>(buffer);
+    while (size > 0) {
+        ssize_t put = write(fd, in, size);
+        if (put < 0 && errno == EINTR) continue;
+        if (put <= 0) return false;
+        in += put;
+        size -= static_cast<size_t>(put);
+    }
+    return true;
+}
+
+// Runs in the forked child: the dictionary is the parent's, shared copy-on-write.
+// Only this thread exists after fork, so the worker stays single-threaded.
+[[noreturn]] void workerMain(const SolverDictionary& dict, const std::vector<ScoringProfile>& profiles, const ShardLayout& layout, int requests, int reports) {
+    ShardRunner runner(dict, profiles, layout);
+    ShardRequest request;
+    while (readFully(requests, &request, sizeof(request)) && request.shard >= 0) {
+        GameTally tally = runner.run(request.shard);
+        ShardReport report{request.shard, {}};
+        std::copy(tally.games.begin(), tally.games.end(), report.games);
+        if (!writeFully(reports, &report, sizeof(report))) break;
+    }
+    _exit(0);
+}
+
+struct WorkerProcess {
+    pid_t pid = -1;
+    int requests = -1; // parent writes shard ids
+    int reports = -1;  // parent reads results
+    int shard = -1;    // shard in flight
+};
+
+void closeWorker(WorkerProcess& worker) {
+    if (worker.requests >= 0) close(worker.requests);
+    if (worker.reports >= 0) close(worker.reports);
+    worker.requests = worker.reports = -1;
+    if (worker.pid > 0) waitpid(worker.pid, nullptr, 0);
+    worker.pid = -1;
+}
+
+bool runInProcesses(const SolverDictionary& dict, const std::vector<ScoringProfile>& profiles, const ShardLayout& layout,
+                    const std::vector<int>& pending, int workerCount, Checkpoint& checkpoint,
+                    const std::function<void()>& shardDone, std::string& error) {
+    // A dead worker must show up as a failed write, not kill the driver
+    struct sigaction ignore = {}, previous = {};
+    ignore.sa_handler = SIG_IGN;
+    sigaction(SIGPIPE, &ignore, &previous);
+
+    std::deque<int> queue(pending.begin(), pending.end());
+    std::vector<WorkerProcess> workers;
+    workerCount = std::min<int>(workerCount, static_cast<int>(pending.size()));
+    for (int w = 0; w < workerCount; ++w) {
+        int requestPipe[2], reportPipe[2];
+        if (pipe(requestPipe) != 0) break;
+        if (pipe(reportPipe) != 0) {
+            close(requestPipe[0]);
+            close(requestPipe[1]);
+            break;
+        }
+        std::fflush(nullptr);
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(requestPipe[1]);
+            close(reportPipe[0]);
+            // Siblings' pipes would otherwise keep them alive after the parent closes them
+            for (WorkerProcess& sibling : workers) {
+                close(sibling.requests);
+                close(sibling.reports);
+            }
+            workerMain(dict, profiles, layout, requestPipe[0], reportPipe[1]);
+        }
+        close(requestPipe[0]);
+        close(reportPipe[1]);
+        if (pid < 0) {
+            close(requestPipe[1]);
+            close(reportPipe[0]);
+            break;
+        }
+        WorkerProcess worker;
+        worker.pid = pid;
+        worker.requests = requestPipe[1];
+        worker.reports = reportPipe[0];
+        workers.push_back(worker);
+    }
+    if (workers.empty()) {
+        sigaction(SIGPIPE, &previous, nullptr);
+        error = "Could not start worker processes";
+        return false;
+    }
+
+    auto dispatch = [&queue](WorkerProcess& worker) {
+        worker.shard = -1;
+        if (queue.empty()) return true;
+        ShardRequest request{queue.front()};
+        if (!writeFully(worker.requests, &request, sizeof(request))) return false;
+        worker.shard = request.shard;
+        queue.pop_front();
+        return true;
+    };
+    auto retire = [&queue](WorkerProcess& worker) {
+        // Whatever it was working on goes back to the queue for the survivors
+        if (worker.shard >= 0) queue.push_front(worker.shard);
+        closeWorker(worker);
+    };
+
+    for (WorkerProcess& worker : workers) {
+        if (!dispatch(worker)) retire(worker);
+    }
+    for (;;) {
+        std::vector<pollfd> fds;
+        std::vector<WorkerProcess *> busy;
+        for (WorkerProcess& worker : workers) {
+            if (worker.pid > 0 && worker.shard < 0 && !queue.empty() && !dispatch(worker)) retire(worker);
+            if (worker.pid > 0 && worker.shard >= 0) {
+                fds.push_back({worker.reports, POLLIN, 0});
+                busy.push_back(&worker);
+            }
+        }
+        if (busy.empty()) break;
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            error = "poll failed while waiting for workers";
+            break;
+        }
+        for (size_t i = 0; i < fds.size(); ++i) {
+            if (!fds[i].revents) continue;
+            WorkerProcess& worker = *busy[i];
+            ShardReport report;
+            if (!readFully(worker.reports, &report, sizeof(report)) || report.shard != worker.shard) {
+                retire(worker);
+                continue;
+            }
+            GameTally tally;
+            std::copy(report.games, report.games + tally.games.size(), tally.games.begin());
+            checkpoint.record(report.shard, tally);
+            shardDone();
+            if (!dispatch(worker)) retire(worker);
+        }
+    }
+
+    for (WorkerProcess& worker : workers) {
+        if (worker.pid <= 0) continue;
+        ShardRequest stop{-1};
+        writeFully(worker.requests, &stop, sizeof(stop));
+        closeWorker(worker);
+    }
+    sigaction(SIGPIPE, &previous, nullptr);
+    if (error.empty() && !queue.empty()) error = "Every worker process exited before the sweep finished";
+    return error.empty();
+}
+
+#endif
+
+} // namespace
+
+// ============================================================================
+// Driver
+// ============================================================================
+
+bool runSweep(const SolverDictionary& dict, const std::vector<ScoringProfile>& profiles, const SweepOptions& options,
+              std::vector<SweepResult>& results, std::string& error, const std::function<void(int done, int total)>& progress) {
+    results.clear();
+    if (dict.answerCount == 0 || profiles.empty()) {
+        error = "Nothing to sweep";
+        return false;
+    }
+    ShardLayout layout(dict.answerCount, std::max(1, options.shardSize), static_cast<int>(profiles.size()));
+    Checkpoint checkpoint(layout.shardCount);
+    if (!checkpoint.open(options.checkpointPath, sweepFingerprint(dict, profiles, layout.shardSize), error)) return false;
+
+    std::vector<int> pending;
+    for (int shard = 0; shard < layout.shardCount; ++shard) {
+        if (!checkpoint.isDone(shard)) pending.push_back(shard);
+    }
+    int done = checkpoint.doneCount();
+    auto shardDone = [&]() {
+        ++done;
+        if (progress) progress(done, layout.shardCount);
+    };
+
+    bool ok = true;
+    if (!pending.empty()) {
+#if defined(_WIN32)
+        runInProcess(dict, profiles, layout, pending, checkpoint, shardDone);
+#else
+        if (options.workers <= 0) {
+            runInProcess(dict, profiles, layout, pending, checkpoint, shardDone);
+        } else {
+            ok = runInProcesses(dict, profiles, layout, pending, options.workers, checkpoint, shardDone, error);
+        }
+#endif
+    }
+    if (!ok) return false;
+
+    for (size_t p = 0; p < profiles.size(); ++p) {
+        SweepResult result;
+        result.profile = profiles[p];
+        for (int s = 0; s < layout.shardsPerProfile; ++s) {
+            result.tally.add(checkpoint.tally(static_cast<int>(p) * layout.shardsPerProfile + s));
+        }
+        results.push_back(result);
+    }
+    return true;
+}
+
+// ============================================================================
+// Tuning
+// ============================================================================
+
+bool tuneScoringProfile(const SolverDictionary& dict, const ScoringProfile& start, const SweepOptions& sweepOptions,
+                        const TuneOptions& tuneOptions, SweepResult& best, std::string& error,
+                        const std::function<void(int round, const SweepResult& best)>& progress) {
+    // A checkpoint is tied to one set of profiles, and every round has its own
+    SweepOptions roundOptions = sweepOptions;
+    roundOptions.checkpointPath.clear();
+    std::vector<SweepResult> results;
+    if (!runSweep(dict, {start}, roundOptions, results, error)) return false;
+    best = results.front();
+
+    std::array<int, SCORING_PROFILE_FIELDS.size()> steps;
+    for (size_t f = 0; f < steps.size(); ++f) {
+        steps[f] = std::max(tuneOptions.minStep, start.*SCORING_PROFILE_FIELDS[f].member / 2);
+    }
+    for (int round = 1; round <= tuneOptions.maxRounds; ++round) {
+        if (std::all_of(steps.begin(), steps.end(), [&](int step) { return step < tuneOptions.minStep; })) break;
+        std::vector<ScoringProfile> candidates;
+        for (size_t f = 0; f < steps.size(); ++f) {
+            if (steps[f] < tuneOptions.minStep) continue;
+            for (int direction : {-1, 1}) {
+                ScoringProfile candidate = best.profile;
+                int& value = candidate.*SCORING_PROFILE_FIELDS[f].member;
+                value = std::max(0, value + direction * steps[f]);
+                if (candidate == best.profile) continue;
+                candidates.push_back(candidate);
+            }
+        }
+        if (!runSweep(dict, candidates, roundOptions, results, error)) return false;
+
+        int winner = -1;
+        for (size_t c = 0; c < results.size(); ++c) {
+            const GameTally& leader = winner < 0 ? best.tally : results[winner].tally;
+            if (results[c].tally.betterThan(leader)) winner = static_cast<int>(c);
+        }
+        if (winner >= 0) {
+            best = results[winner];
+        } else {
+            for (int& step : steps) step /= 2;
+        }
+        if (progress) progress(round, best);
+    }
+    return true;
+}
@@ -0,0 +1,44 @@
+#ifndef SOLVERSWEEP_H
+#define SOLVERSWEEP_H
+
+#include "HeuristicScoring.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+// Batch evaluation of scoring profiles: every profile plays every answer. Work is cut
+// into (profile, block of answers) shards and handed to forked worker processes,
+// which inherit the already loaded dictionary instead of reading it again. Finished
+// shards are appended to a checkpoint file, so an interrupted sweep resumes where
+// it stopped.
+struct SweepOptions {
+    int workers = 0;             // worker processes; 0 runs shards on threads in this process
+    int shardSize = 256;         // answers per shard
+    std::string checkpointPath;  // optional; created if missing, resumed if it matches
+};
+
+struct SweepResult {
+    ScoringProfile profile;
+    GameTally tally;
+};
+
+// progress(done, total) is called after each shard; results come back in profile order
+bool runSweep(const SolverDictionary& dict, const std::vector<ScoringProfile>& profiles, const SweepOptions& options,
+              std::vector<SweepResult>& results, std::string& error,
+              const std::function<void(int done, int total)>& progress = {});
+
+// Coordinate descent over the profile constants: each round plays every answer with
+// the current profile nudged up and down by a step in each constant (one sweep, so
+// the candidates run in parallel), moves to the best improvement, and halves the
+// steps when nothing improves.
+struct TuneOptions {
+    int maxRounds = 20;
+    int minStep = 50;   // stop once every step is below this
+};
+
+// progress(round, best) is called after each round
+bool tuneScoringProfile(const SolverDictionary& dict, const ScoringProfile& start, const SweepOptions& sweepOptions,
+                        const TuneOptions& tuneOptions, SweepResult& best, std::string& error,
+                        const std::function<void(int round, const SweepResult& best)>& progress = {});
+
+#endif // SOLVERSWEEP_H
@@ -0,0 +1,334 @@
+#include "SolverVerify.h"
+#include "WordleWindow.h"
+#include "HeuristicScoring.h"
+#include "SolverReverse.h"
+#include <QLatin1String>
+#include <QString>
+#include <QVector>
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Counts every mismatch, keeps the first few for the report
+class MismatchLog {
+public:
+    explicit MismatchLog(const char *check) : check(check) {}
+
+    void add(const std::string& detail) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (++count <= MAX_SHOWN) samples.push_back(detail);
+    }
+
+    int total() const { return count; }
+
+    void print(long long compared, double seconds) const {
+        std::printf("%-9s %lld compared in %.2f s, %d mismatches\n", check, compared, seconds, count);
+        for (const std::string& sample : samples) std::printf("  %s\n", sample.c_str());
+    }
+
+private:
+    static constexpr int MAX_SHOWN = 10;
+    const char *check;
+    std::mutex mutex;
+    int count = 0;
+    std::vector<std::string> samples;
+};
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ============================================================================
+// Feedback
+// ============================================================================
+
+long long verifyFeedback(const SolverDictionary& dict, MismatchLog& log) {
+    const QStringList& words = dictionaryWords();
+    parallelFor(dict.size(), [&](int begin, int end) {
+        for (int guess = begin; guess < end; ++guess) {
+            for (int answer = 0; answer < dict.answerCount; ++answer) {
+                QString legacy = feedbackFor(words[guess], words[answer]);
+                std::string packed = patternToString(computeFeedback(dict.packed[guess], dict.packed[answer]));
+                if (legacy == QLatin1String(packed.c_str())) continue;
+                log.add(dict.words[guess] + " against " + dict.words[answer] + ": legacy " + legacy.toStdString()
+                        + ", packed " + packed);
+            }
+        }
+    });
+    return static_cast<long long>(dict.size()) * dict.answerCount;
+}
+
+// ============================================================================
+// Constraint filter and heuristic scores
+// ============================================================================
+
+struct GameState {
+    std::string rows; // "CRANE XYGXX, ..."
+    SolverConstraints constraints;
+};
+
+void addRow(const SolverDictionary& dict, GameState& state, int guess, uint8_t pattern) {
+    if (!state.rows.empty()) state.rows += ", ";
+    state.rows += dict.words[guess] + " " + patternToString(pattern);
+    addFeedback(state.constraints, dict.packed[guess], pattern);
+}
+
+// Every feedback the opening guess can get (impossible ones included), then random games
+std::vector<GameState> buildStates(const SolverDictionary& dict, int openingGuess, int randomStates, unsigned seed) {
+    std::vector<GameState> states;
+    for (int pattern = 0; pattern < PATTERN_COUNT; ++pattern) {
+        GameState state;
+        addRow(dict, state, openingGuess, static_cast<uint8_t>(pattern));
+        states.push_back(state);
+    }
+    std::mt19937 random(seed);
+    for (int s = 0; s < randomStates; ++s) {
+        int answer = static_cast<int>(random() % dict.answerCount);
+        int rows = 1 + static_cast<int>(random() % 4);
+        GameState state;
+        for (int row = 0; row < rows; ++row) {
+            int guess = static_cast<int>(random() % dict.size());
+            addRow(dict, state, guess, computeFeedback(dict.packed[guess], dict.packed[answer]));
+        }
+        states.push_back(state);
+    }
+    return states;
+}
+
+// The QMap/QSet form the solver window reads out of its input boxes
+struct LegacyConstraints {
+    QMap<int, QChar> greenLetters;
+    QMap<QChar, QSet<int>> yellowPositions;
+    QSet<QChar> yellowLetters;
+    QSet<QChar> grayLetters;
+};
+
+LegacyConstraints toLegacyConstraints(const SolverAlphabet& alphabet, const SolverConstraints& constraints) {
+    auto letter = [&alphabet](int index) { return QChar(static_cast<char16_t>(alphabet.symbol(index))); };
+    auto forEachLetter = [](LetterMask mask, auto&& body) {
+        for (; mask; mask &= mask - 1) body(std::countr_zero(mask));
+    };
+    LegacyConstraints legacy;
+    for (int i = 0; i < WORD_LENGTH; ++i) {
+        if (constraints.green[i] >= 0) legacy.greenLetters[i] = letter(constraints.green[i]);
+        forEachLetter(constraints.yellowForbidden[i], [&](int index) { legacy.yellowPositions[letter(index)].insert(i); });
+    }
+    forEachLetter(constraints.yellowLetters, [&](int index) { legacy.yellowLetters.insert(letter(index)); });
+    forEachLetter(constraints.grayLetters, [&](int index) { legacy.grayLetters.insert(letter(index)); });
+    return legacy;
+}
+
+long long verifyConstraints(const SolverDictionary& dict, const HeuristicScorer& scorer, const std::vector<GameState>& states, MismatchLog& log) {
+    CandidateSet answers = dict.allAnswers();
+    CandidateSet accepted = dict.allAccepted();
+    parallelFor(static_cast<int>(states.size()), [&](int begin, int end) {
+        std::vector<int> legacyScore(dict.size());
+        for (int s = begin; s < end; ++s) {
+            const GameState& state = states[s];
+            LegacyConstraints legacy = toLegacyConstraints(dict.alphabet, state.constraints);
+            std::fill(legacyScore.begin(), legacyScore.end(), INT_MIN); // INT_MIN: filtered out
+            for (const QPair<QString, int>& scored : getAllValidWordsWithConstraints(answers, accepted, legacy.greenLetters, legacy.yellowPositions, legacy.yellowLetters, legacy.grayLetters)) {
+                int index = dict.indexOf(scored.first.toStdString());
+                if (index >= 0) legacyScore[index] = scored.second;
+            }
+            for (int word = 0; word < dict.size(); ++word) {
+                bool packedKeeps = matchesConstraints(dict.packed[word], state.constraints);
+                bool legacyKeeps = legacyScore[word] != INT_MIN;
+                if (packedKeeps != legacyKeeps) {
+                    log.add(state.rows + ": " + dict.words[word] + (legacyKeeps ? " kept only by legacy" : " kept only by packed"));
+                } else if (packedKeeps && scorer.score(word, state.constraints) != legacyScore[word]) {
+                    log.add(state.rows + ": " + dict.words[word] + " scores " + std::to_string(legacyScore[word])
+                            + " legacy, " + std::to_string(scorer.score(word, state.constraints)) + " packed");
+                }
+            }
+        }
+    });
+    return static_cast<long long>(states.size()) * dict.size();
+}
+
+// ============================================================================
+// Lookahead pruning
+// ============================================================================
+
+// Lookahead ranked with a short first page, which prunes head guesses once that page is
+// full, against the same head with a first page as wide as the head, which never
+// prunes: the leaders must be the same guesses with the same exact two-step sizes
+long long verifyLookahead(const SolverDictionary& dict, const std::vector<GameState>& states, MismatchLog& log) {
+    const int PRUNED_PAGE = 3;
+    const int MAX_STATES = 20;
+    std::vector<std::pair<std::string, CandidateList>> positions = {{"(opening)", dict.allAnswers().toList()}};
+    for (const GameState& state : states) {
+        if (static_cast<int>(positions.size()) > MAX_STATES) break;
+        CandidateList candidates;
+        dict.allAnswers().forEach([&](int answer) {
+            if (matchesConstraints(dict.packed[answer], state.constraints)) candidates.push_back(answer);
+        });
+        if (candidates.size() > PRUNED_PAGE) positions.emplace_back(state.rows, candidates);
+    }
+    for (const auto& [rows, candidates] : positions) {
+        std::vector<GuessMetrics> pruned = rankGuesses(dict, candidates, RankingMode::Lookahead, PRUNED_PAGE).page(0, PRUNED_PAGE);
+        std::vector<GuessMetrics> full = rankGuesses(dict, candidates, RankingMode::Lookahead, LOOKAHEAD_WIDTH).page(0, PRUNED_PAGE);
+        for (size_t i = 0; i < std::max(pruned.size(), full.size()); ++i) {
+            if (i < pruned.size() && i < full.size() && pruned[i].guess == full[i].guess && pruned[i].lookaheadSize == full[i].lookaheadSize
+                && !pruned[i].lookaheadBound) {
+                continue;
+            }
+            auto describe = [&dict](const std::vector<GuessMetrics>& ranked, size_t i) {
+                return i < ranked.size() ? dict.words[ranked[i].guess] + " " + std::to_string(ranked[i].lookaheadSize) : std::string("(none)");
+            };
+            log.add(rows + ": #" + std::to_string(i + 1) + " pruned " + describe(pruned, i) + ", unpruned " + describe(full, i));
+            break;
+        }
+    }
+    return static_cast<long long>(positions.size());
+}
+
+// ============================================================================
+// Reverse solver
+// ============================================================================
+
+// Consistent sequences by plain enumeration: every word for each row's colors, kept
+// when it differs from and agrees with every word played before it; -1 past budget
+// words tried
+double bruteForceSequences(const SolverDictionary& dict, int answer, const std::vector<uint8_t>& patterns, long long budget) {
+    std::vector<std::vector<int>> rowWords(patterns.size());
+    for (int word = 0; word < dict.size(); ++word) {
+        uint8_t pattern = computeFeedback(dict.packed[word], dict.packed[answer]);
+        for (size_t row = 0; row < patterns.size(); ++row) {
+            if (patterns[row] == pattern) rowWords[row].push_back(word);
+        }
+    }
+    std::vector<int> played;
+    double total = 0.0;
+    long long tried = 0;
+    auto extend = [&](auto&& self, size_t row) -> void {
+        if (row == patterns.size()) {
+            ++total;
+            return;
+        }
+        for (int word : rowWords[row]) {
+            if (++tried > budget) return;
+            bool agrees = true;
+            for (size_t before = 0; before < played.size() && agrees; ++before) {
+                agrees = word != played[before] && computeFeedback(dict.packed[played[before]], dict.packed[word]) == patterns[before];
+            }
+            if (!agrees) continue;
+            played.push_back(word);
+            self(self, row + 1);
+            played.pop_back();
+        }
+    };
+    extend(extend, 0);
+    return tried > budget ? -1.0 : total;
+}
+
+// reverseSolve's consistent-sequence count against bruteForceSequences, for a few fixed
+// grids and the grids of heuristic games spread over the answer list. Grids too large
+// to enumerate within the budget are left out; reverseSolve must count the rest.
+long long verifyReverse(const SolverDictionary& dict, const HeuristicScorer& scorer, MismatchLog& log) {
+    const int GAMES = 12;
+    const long long BUDGET = 2000000;
+    std::vector<std::pair<int, std::vector<uint8_t>>> grids;
+    const std::pair<const char *, const char *> fixedGrids[] = {
+        {"CRANE", "XXYXX\nXGYXY\nGGGGG"},
+        {"CRANE", "XXXXX\nYXXXX\nGGGGG"},
+        {"PLANT", "XXGXX\nXGGYX\nGGGGG"},
+        {"SOUND", "YXXXX\nXXGXY\nXGGGG\nGGGGG"},
+    };
+    for (const auto& [word, text] : fixedGrids) {
+        int answer = dict.indexOf(word);
+        std::vector<uint8_t> patterns;
+        std::string error;
+        if (answer >= 0 && parseShareGrid(text, patterns, error)) grids.emplace_back(answer, patterns);
+    }
+    for (int game = 0; game < GAMES && dict.answerCount > 0; ++game) {
+        int answer = static_cast<int>(static_cast<long long>(game) * dict.answerCount / GAMES);
+        SolverConstraints constraints;
+        std::vector<uint8_t> patterns;
+        while (static_cast<int>(patterns.size()) < MAX_GUESSES && (patterns.empty() || patterns.back() != PATTERN_COUNT - 1)) {
+            int guess = scorer.bestGuess(constraints);
+            if (guess < 0) break;
+            patterns.push_back(computeFeedback(dict.packed[guess], dict.packed[answer]));
+            addFeedback(constraints, dict.packed[guess], patterns.back());
+        }
+        if (!patterns.empty()) grids.emplace_back(answer, patterns);
+    }
+    long long compared = 0;
+    for (const auto& [answer, patterns] : grids) {
+        std::string grid;
+        for (uint8_t pattern : patterns) grid += (grid.empty() ? "" : "/") + patternToString(pattern);
+        double expected = bruteForceSequences(dict, answer, patterns, BUDGET);
+        if (expected < 0) continue;
+        ReverseSolution solution = reverseSolve(dict, ReverseIndex::build(dict, answer), patterns, BUDGET);
+        ++compared;
+        if (solution.consistentSequences == expected) continue;
+        log.add(grid + " against " + dict.words[answer] + ": reverse " + std::to_string(static_cast<long long>(solution.consistentSequences))
+                + ", brute force " + std::to_string(static_cast<long long>(expected)));
+    }
+    return compared;
+}
+
+} // namespace
+
+int runSolverVerification(int argc, char *argv[]) {
+    int randomStates = 500;
+    unsigned seed = 1;
+    for (int i = 1; i + 1 < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--states") randomStates = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--seed") seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    const SolverDictionary& dict = sharedSolverDictionary();
+    if (dict.answerCount == 0) {
+        std::fprintf(stderr, "No valid answer words\n");
+        return 1;
+    }
+    dictionaryWords(); // convert up front so the feedback timing covers only the comparison
+
+    MismatchLog feedbackLog("feedback");
+    auto start = std::chrono::steady_clock::now();
+    long long pairs = verifyFeedback(dict, feedbackLog);
+    feedbackLog.print(pairs, secondsSince(start));
+
+    MismatchLog filterLog("filter");
+    start = std::chrono::steady_clock::now();
+    HeuristicScorer scorer(dict, defaultScoringProfile());
+    std::vector<GameState> states = buildStates(dict, scorer.bestGuess(SolverConstraints()), randomStates, seed);
+    long long words = verifyConstraints(dict, scorer, states, filterLog);
+    filterLog.print(words, secondsSince(start));
+
+    MismatchLog openingLog("opening");
+    std::vector<QPair<QString, int>> legacyOpening = rankStartingWords(dict.allAnswers(), dict.allAccepted()).page(0, 1);
+    int packedOpening = scorer.bestGuess(SolverConstraints());
+    std::string legacyWord = legacyOpening.empty() ? "(none)" : legacyOpening.front().first.toStdString();
+    std::string packedWord = packedOpening >= 0 ? dict.words[packedOpening] : "(none)";
+    if (legacyWord != packedWord) openingLog.add("legacy " + legacyWord + ", packed " + packedWord);
+    openingLog.print(1, 0.0);
+
+    MismatchLog lookaheadLog("lookahead");
+    start = std::chrono::steady_clock::now();
+    long long positions = verifyLookahead(dict, states, lookaheadLog);
+    lookaheadLog.print(positions, secondsSince(start));
+
+    MismatchLog reverseLog("reverse");
+    start = std::chrono::steady_clock::now();
+    long long grids = verifyReverse(dict, scorer, reverseLog);
+    reverseLog.print(grids, secondsSince(start));
+
+    int mismatches = feedbackLog.total() + filterLog.total() + openingLog.total() + lookaheadLog.total() + reverseLog.total();
+    if (mismatches == 0) {
+        std::printf("Legacy and packed paths agree\n");
+        return 0;
+    }
+    std::printf("%d mismatches\n", mismatches);
+    return 1;
+}
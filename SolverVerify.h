@@ -0,0 +1,14 @@
+#ifndef SOLVERVERIFY_H
+#define SOLVERVERIFY_H
+
+// Differential check of the legacy QString/QMap paths against the packed solver core:
+// feedbackFor vs computeFeedback for every guess x answer pair, and
+// getAllValidWordsWithConstraints vs matchesConstraints + HeuristicScorer over every
+// feedback to the opening guess plus random multi-guess states, and lookahead ranking
+// with pruning against the unpruned ranking on some of those states, and the reverse
+// solver's consistent-sequence counts against brute force on sample grids. Options:
+// --states N (random states, default 500) and --seed N. Prints each mismatch class
+// and returns a process exit code, 0 when both paths agree everywhere.
+int runSolverVerification(int argc, char *argv[]);
+
+#endif // SOLVERVERIFY_H
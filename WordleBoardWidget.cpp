@@ -0,0 +1,151 @@
+#include "WordleBoardWidget.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QStringList>
+#include <algorithm>
+
+namespace {
+
+const int TILE_SIZE = 44;
+const int TILE_GAP = 6;
+const int KEY_WIDTH = 30;
+const int KEY_HEIGHT = 36;
+const int KEY_GAP = 4;
+const int SECTION_GAP = 16; // between the grid and the keyboard
+const int MARGIN = 4;
+
+int spanWidth(int count, int size, int gap) {
+    return count > 0 ? count * size + (count - 1) * gap : 0;
+}
+
+} // namespace
+
+WordleBoardWidget::WordleBoardWidget(const SolverAlphabet &alphabet, int rows, QWidget *parent) : QWidget(parent), rows(rows) {
+    // Keys come from the dictionary's alphabet: QWERTY rows for the letters it uses,
+    // then any other letters (Ñ, umlauts, ...) on extra rows in alphabet order
+    const QStringList qwertyRows = {"QWERTYUIOP", "ASDFGHJKL", "ZXCVBNM"};
+    const int extraRowLength = 10;
+    QVector<bool> placed(alphabet.size(), false);
+    for (const QString &rowLetters : qwertyRows) {
+        QVector<int> row;
+        for (QChar c : rowLetters) {
+            int index = alphabet.indexOf(c.unicode());
+            if (index >= 0) {
+                row.append(index);
+                placed[index] = true;
+            }
+        }
+        keyboardRows.append(row);
+    }
+    for (int index = 0; index < alphabet.size(); ++index) {
+        if (placed[index]) continue;
+        if (keyboardRows.size() == qwertyRows.size() || keyboardRows.last().size() == extraRowLength) keyboardRows.append(QVector<int>());
+        keyboardRows.last().append(index);
+    }
+
+    keyPosition.fill(QPoint(), alphabet.size());
+    for (int r = 0; r < keyboardRows.size(); ++r) {
+        for (int c = 0; c < keyboardRows[r].size(); ++c) keyPosition[keyboardRows[r][c]] = QPoint(c, r);
+    }
+    for (int index = 0; index < alphabet.size(); ++index) {
+        char32_t symbol = alphabet.symbol(index);
+        glyphs.append(QString::fromUcs4(&symbol, 1));
+    }
+    tileLetters.fill(-1, rows * WORD_LENGTH);
+    tileStates.fill(0, rows * WORD_LENGTH);
+    keyStates.fill(0, alphabet.size());
+
+    const QColor stateColors[STATE_COUNT] = {Qt::white, QColor("gray"), QColor("orange"), QColor("green")};
+    for (int state = 0; state < STATE_COUNT; ++state) {
+        stateBrushes[state] = QBrush(stateColors[state]);
+        stateTextPens[state] = QPen(state == 0 ? Qt::black : Qt::white);
+    }
+    borderPen = QPen(Qt::gray);
+    tileFont.setPixelSize(24);
+    tileFont.setBold(true);
+    keyFont.setPixelSize(14);
+    keyFont.setBold(true);
+    setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed);
+}
+
+void WordleBoardWidget::addRow(const PackedWord &letters, uint8_t pattern) {
+    if (rowsFilled == rows) return;
+    for (int i = 0; i < WORD_LENGTH; ++i, pattern /= 3) {
+        int letter = letters[i];
+        uint8_t state = static_cast<uint8_t>(pattern % 3 + 1);
+        tileLetters[rowsFilled * WORD_LENGTH + i] = letter;
+        tileStates[rowsFilled * WORD_LENGTH + i] = state;
+        update(tileRect(rowsFilled, i));
+        if (state > keyStates[letter]) {
+            keyStates[letter] = state;
+            update(keyRect(letter));
+        }
+    }
+    ++rowsFilled;
+}
+
+void WordleBoardWidget::reset() {
+    tileLetters.fill(-1);
+    tileStates.fill(0);
+    keyStates.fill(0);
+    rowsFilled = 0;
+    update();
+}
+
+QSize WordleBoardWidget::sizeHint() const {
+    int width = spanWidth(WORD_LENGTH, TILE_SIZE, TILE_GAP);
+    for (const QVector<int> &row : keyboardRows) width = std::max(width, spanWidth(row.size(), KEY_WIDTH, KEY_GAP));
+    int height = keyboardTop() + spanWidth(keyboardRows.size(), KEY_HEIGHT, KEY_GAP) + MARGIN;
+    return QSize(width + 2 * MARGIN, height);
+}
+
+int WordleBoardWidget::keyboardTop() const {
+    return MARGIN + spanWidth(rows, TILE_SIZE, TILE_GAP) + SECTION_GAP;
+}
+
+QRect WordleBoardWidget::tileRect(int row, int column) const {
+    int left = (width() - spanWidth(WORD_LENGTH, TILE_SIZE, TILE_GAP)) / 2;
+    return QRect(left + column * (TILE_SIZE + TILE_GAP), MARGIN + row * (TILE_SIZE + TILE_GAP), TILE_SIZE, TILE_SIZE);
+}
+
+QRect WordleBoardWidget::keyRect(int letter) const {
+    QPoint position = keyPosition[letter];
+    int left = (width() - spanWidth(keyboardRows[position.y()].size(), KEY_WIDTH, KEY_GAP)) / 2;
+    return QRect(left + position.x() * (KEY_WIDTH + KEY_GAP), keyboardTop() + position.y() * (KEY_HEIGHT + KEY_GAP), KEY_WIDTH, KEY_HEIGHT);
+}
+
+void WordleBoardWidget::paintEvent(QPaintEvent *event) {
+    QPainter painter(this);
+    const QRegion &dirty = event->region();
+
+    painter.setFont(tileFont);
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < WORD_LENGTH; ++column) {
+            QRect rect = tileRect(row, column);
+            if (!dirty.intersects(rect)) continue;
+            int tile = row * WORD_LENGTH + column;
+            int state = tileStates[tile];
+            painter.fillRect(rect, stateBrushes[state]);
+            if (state == 0) {
+                painter.setPen(borderPen);
+                painter.drawRect(rect.adjusted(0, 0, -1, -1));
+            }
+            if (tileLetters[tile] >= 0) {
+                painter.setPen(stateTextPens[state]);
+                painter.drawText(rect, Qt::AlignCenter, glyphs[tileLetters[tile]]);
+            }
+        }
+    }
+
+    painter.setFont(keyFont);
+    for (int letter = 0; letter < keyStates.size(); ++letter) {
+        QRect rect = keyRect(letter);
+        if (!dirty.intersects(rect)) continue;
+        int state = keyStates[letter];
+        painter.fillRect(rect, stateBrushes[state]);
+        painter.setPen(borderPen);
+        painter.drawRect(rect.adjusted(0, 0, -1, -1));
+        painter.setPen(stateTextPens[state]);
+        painter.drawText(rect, Qt::AlignCenter, glyphs[letter]);
+    }
+}
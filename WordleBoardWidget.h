@@ -0,0 +1,51 @@
+#ifndef WORDLEBOARDWIDGET_H
+#define WORDLEBOARDWIDGET_H
+
+#include <QBrush>
+#include <QFont>
+#include <QPen>
+#include <QVector>
+#include <QWidget>
+#include "SolverCore.h"
+
+// Guess grid and on-screen keyboard in one painted widget. Tile and key states live in
+// plain arrays; a move records its row, raises key states and repaints only the tiles
+// and keys it touched, with every brush, pen, font and glyph prepared up front.
+class WordleBoardWidget : public QWidget {
+public:
+    WordleBoardWidget(const SolverAlphabet &alphabet, int rows, QWidget *parent = nullptr);
+
+    // letters are alphabet indices; pattern uses the solver's base-3 digits
+    void addRow(const PackedWord &letters, uint8_t pattern);
+    void reset();
+    int filledRows() const { return rowsFilled; }
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    // 0=empty/unused, 1=gray, 2=yellow, 3=green, the same order as the letter states elsewhere
+    static constexpr int STATE_COUNT = 4;
+
+    QRect tileRect(int row, int column) const;
+    QRect keyRect(int letter) const;
+    int keyboardTop() const;
+
+    int rows;
+    int rowsFilled = 0;
+    QVector<QString> glyphs;                   // by alphabet letter
+    QVector<QVector<int>> keyboardRows;        // alphabet letters, row by row
+    QVector<QPoint> keyPosition;               // by alphabet letter: keyboard row, column
+    QVector<int> tileLetters;                  // rows * WORD_LENGTH, -1 while empty
+    QVector<uint8_t> tileStates;
+    QVector<uint8_t> keyStates;                // by alphabet letter
+    QBrush stateBrushes[STATE_COUNT];
+    QPen stateTextPens[STATE_COUNT];
+    QPen borderPen;
+    QFont tileFont;
+    QFont keyFont;
+};
+
+#endif // WORDLEBOARDWIDGET_H
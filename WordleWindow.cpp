@@ -1,12 +1,14 @@
 #include "WordleWindow.h"
+#include "DictionaryLoader.h"
+#include "HeuristicScoring.h"
+#include "SolverQuery.h"
+#include "WordleBoardWidget.h"
 #include <QLineEdit>
 #include <QPushButton>
 #include <QLabel>
 #include <QVBoxLayout>
 #include <QMessageBox>
 #include <QRandomGenerator>
-#include <QFile>
-#include <QTextStream>
 #include <QSet>
 #include <QTextEdit>
 #include <QApplication>
@@ -15,68 +17,250 @@
 #include <QMap>
 #include <QVector>
 #include <QStringList>
+#include <QComboBox>
+#include <QThreadPool>
+#include <QPointer>
+#include <QRegularExpression>
+#include <QHash>
 #include <algorithm>
+#include <cmath>
+#include <mutex>
 
 // Forward declaration for shared optimal guess function
-QString findOptimalGuessShared(const QSet<QString> &answerWords, const QSet<QString> &acceptedWords, const QList<QPair<QString, QString>> &guessFeedbackPairs, const QMap<int, QChar> &greenLetters, const QMap<QChar, QSet<int>> &yellowPositions, const QSet<QChar> &yellowLetters, const QSet<QChar> &grayLetters);
-QString findOptimalGuessWithConstraints(const QSet<QString>& answerWords, const QSet<QString>& acceptedWords, const QMap<int, QChar>& greenLetters, const QMap<QChar, QSet<int>>& yellowPositions, const QSet<QChar>& yellowLetters, const QSet<QChar>& grayLetters);
-
-// Global function to load word lists
-static QStringList loadWordList(const QString &filename) {
-    QStringList words;
-    QFile file(filename);
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&file);
-        while (!in.atEnd()) {
-            QString word = in.readLine().trimmed().toUpper();
-            if (!word.isEmpty()) words << word;
+QString findOptimalGuessShared(const CandidateSet &answerWords, const CandidateSet &acceptedWords, const QList<QPair<QString, QString>> &guessFeedbackPairs, const QMap<int, QChar> &greenLetters, const QMap<QChar, QSet<int>> &yellowPositions, const QSet<QChar> &yellowLetters, const QSet<QChar> &grayLetters);
+QString findOptimalGuessWithConstraints(const CandidateSet& answerWords, const CandidateSet& acceptedWords, const QMap<int, QChar>& greenLetters, const QMap<QChar, QSet<int>>& yellowPositions, const QSet<QChar>& yellowLetters, const QSet<QChar>& grayLetters);
+
+const SolverDictionary& sharedSolverDictionary() {
+    static const SolverDictionary dict = [] {
+        DictionaryLoadReport report;
+        return loadSolverDictionary(defaultDictionarySources(), report);
+    }();
+    return dict;
+}
+
+const QStringList& dictionaryWords() {
+    static const QStringList words = [] {
+        QStringList converted;
+        for (const std::string &word : sharedSolverDictionary().words) converted << QString::fromStdString(word);
+        return converted;
+    }();
+    return words;
+}
+
+// Letter/position postings for the solver window's query box
+static const WordIndex& sharedWordIndex() {
+    static const WordIndex index = WordIndex::build(sharedSolverDictionary());
+    return index;
+}
+
+// Word lists as the windows expect them, taken from the validated dictionary
+static QStringList answerWordList() {
+    return dictionaryWords().mid(0, sharedSolverDictionary().answerCount);
+}
+
+static QStringList acceptedWordList() {
+    return dictionaryWords().mid(sharedSolverDictionary().answerCount);
+}
+
+// Rankings shared by every window and by the background pre-warming tasks. The
+// pattern matrix is built on a pool thread (unless the lists are too large for one);
+// rankings compute feedback until it lands. Opening rankings of the compiled-in lists
+// are there from the start.
+static SolverCache& sharedSolverCache() {
+    static SolverCache cache;
+    static std::once_flag patternsStarted;
+    std::call_once(patternsStarted, []() {
+        seedOpenerRankings(sharedSolverDictionary(), cache);
+        if (!PatternMatrix::fits(sharedSolverDictionary())) return;
+        QThreadPool::globalInstance()->start([]() {
+            cache.setPatternMatrix(std::make_shared<const PatternMatrix>(PatternMatrix::build(sharedSolverDictionary())));
+        });
+    });
+    return cache;
+}
+
+// Ranks the likely follow-up states of guess on an idle pool thread. Bumping
+// generation cancels any earlier task, so only the latest typed guess is warmed.
+static void startPrewarm(const std::shared_ptr<std::atomic<int>> &generation, const CandidateSet &candidates, int guess, RankingMode mode) {
+    const int PREWARM_BUCKETS = 8;
+    int myGeneration = ++*generation;
+    if (candidates.count() <= 1 || guess < 0) return;
+    QThreadPool::globalInstance()->start([generation, myGeneration, candidates, guess, mode]() {
+        prewarmFollowUps(sharedSolverDictionary(), candidates, guess, mode, PREWARM_BUCKETS, sharedSolverCache(), [&]() {
+            return generation->load() != myGeneration;
+        });
+    });
+}
+
+// Reconstructs the constraint form from the game's rows
+static void constraintsFromRows(const QVector<QString> &guesses, const QVector<QString> &feedbacks, QMap<int, QChar> &greenLetters, QMap<QChar, QSet<int>> &yellowPositions, QSet<QChar> &yellowLetters, QSet<QChar> &grayLetters) {
+    for (int i = 0; i < guesses.size(); ++i) {
+        QString guess = guesses[i];
+        QString feedback = feedbacks[i];
+        for (int j = 0; j < 5; ++j) {
+            QChar letter = guess[j];
+            if (feedback[j] == 'G') {
+                greenLetters[j] = letter;
+            } else if (feedback[j] == 'Y') {
+                yellowLetters.insert(letter);
+                yellowPositions[letter].insert(j);
+            } else if (feedback[j] == 'X') {
+                bool isAlsoYellowOrGreen = false;
+                for (int k = 0; k < 5; ++k) {
+                    if (k != j && guess[k] == letter && feedback[k] != 'X') {
+                        isAlsoYellowOrGreen = true;
+                        break;
+                    }
+                }
+                if (!isAlsoYellowOrGreen) {
+                    grayLetters.insert(letter);
+                }
+            }
         }
     }
-    return words;
+}
+
+// The game window's hint: the heuristic pick over every word under the constraints
+// the rows imply. Hints are kept by rows, filled by the hint itself and by the
+// background warming of the row being typed, and the least recently used one goes
+// first, as in SolverCache.
+struct CachedHint {
+    QString hint;
+    quint64 lastUse;
+};
+
+static QString heuristicHint(const QVector<QString> &guesses, const QVector<QString> &feedbacks) {
+    const int MAX_HINTS = 256;
+    static std::mutex hintsMutex;
+    static QHash<QString, CachedHint> hints;
+    static quint64 useClock = 0;
+    QString key;
+    for (int i = 0; i < guesses.size(); ++i) key += guesses[i] + ':' + feedbacks[i] + ' ';
+    {
+        std::lock_guard<std::mutex> lock(hintsMutex);
+        auto found = hints.find(key);
+        if (found != hints.end()) {
+            found->lastUse = ++useClock;
+            return found->hint;
+        }
+    }
+    QMap<int, QChar> greenLetters;
+    QMap<QChar, QSet<int>> yellowPositions;
+    QSet<QChar> yellowLetters;
+    QSet<QChar> grayLetters;
+    constraintsFromRows(guesses, feedbacks, greenLetters, yellowPositions, yellowLetters, grayLetters);
+    const SolverDictionary &dict = sharedSolverDictionary();
+    CandidateSet words = dict.allAnswers() | dict.allAccepted();
+    QString hint = findOptimalGuessWithConstraints(words, words, greenLetters, yellowPositions, yellowLetters, grayLetters);
+    std::lock_guard<std::mutex> lock(hintsMutex);
+    if (hints.size() >= MAX_HINTS && !hints.contains(key)) {
+        auto oldest = std::min_element(hints.begin(), hints.end(), [](const CachedHint &a, const CachedHint &b) {
+            return a.lastUse < b.lastUse;
+        });
+        hints.erase(oldest);
+    }
+    hints.insert(key, CachedHint{hint, ++useClock});
+    return hint;
+}
+
+// Works out the hint after each likely feedback of the typed guess on an idle pool
+// thread, so it is ready when the row is entered. Bumping generation cancels it.
+static void startHintPrewarm(const std::shared_ptr<std::atomic<int>> &generation, const CandidateSet &candidates, const QVector<QString> &guesses, const QVector<QString> &feedbacks, int guess) {
+    const int PREWARM_BUCKETS = 8;
+    int myGeneration = ++*generation;
+    if (candidates.count() <= 1 || guess < 0) return;
+    QThreadPool::globalInstance()->start([generation, myGeneration, candidates, guesses, feedbacks, guess]() {
+        const SolverDictionary &dict = sharedSolverDictionary();
+        PatternHistogram sizes;
+        feedbackHistogram(dict, guess, candidates.toList(), sizes);
+        std::vector<int> patterns;
+        for (int p = 0; p < PATTERN_COUNT; ++p) {
+            if (p != ALL_GREEN_PATTERN && sizes[p] > 1) patterns.push_back(p);
+        }
+        // Under a uniform prior a bucket's probability is its size
+        keepTop(patterns, PREWARM_BUCKETS, [&sizes](int a, int b) { return sizes[a] > sizes[b]; });
+        QString word = QString::fromStdString(dict.words[guess]);
+        for (int pattern : patterns) {
+            if (generation->load() != myGeneration) return;
+            heuristicHint(QVector<QString>(guesses) << word, QVector<QString>(feedbacks) << QString::fromStdString(patternToString(static_cast<uint8_t>(pattern))));
+        }
+    });
+}
+
+// Converts the QMap/QSet constraint form used by the windows into packed letter masks
+static SolverConstraints toSolverConstraints(const QMap<int, QChar> &greenLetters, const QMap<QChar, QSet<int>> &yellowPositions, const QSet<QChar> &yellowLetters, const QSet<QChar> &grayLetters) {
+    const SolverAlphabet &alphabet = sharedSolverDictionary().alphabet;
+    auto letterIndex = [&alphabet](QChar c) { return alphabet.indexOf(c.unicode()); };
+    SolverConstraints constraints;
+    for (auto it = greenLetters.begin(); it != greenLetters.end(); ++it) {
+        // A letter outside the alphabet can never match, so keep the square impossible
+        int letter = letterIndex(it.value());
+        constraints.green[it.key()] = letter >= 0 ? letter : MAX_ALPHABET_SIZE;
+    }
+    for (auto it = yellowPositions.begin(); it != yellowPositions.end(); ++it) {
+        int letter = letterIndex(it.key());
+        if (letter < 0) continue;
+        for (int pos : it.value()) constraints.yellowForbidden[pos] |= LetterMask(1) << letter;
+    }
+    for (QChar c : yellowLetters) {
+        int letter = letterIndex(c);
+        if (letter >= 0) constraints.yellowLetters |= LetterMask(1) << letter;
+    }
+    for (QChar c : grayLetters) {
+        int letter = letterIndex(c);
+        if (letter >= 0) constraints.grayLetters |= LetterMask(1) << letter;
+    }
+    return constraints;
 }
 
 // Add this function after the includes:
-QVector<QPair<QString, int>> getBestStartingWords(const QSet<QString>& answerWords, const QSet<QString>& acceptedWords, int topN = 10) {
+HeuristicRanking rankStartingWords(const CandidateSet& answerWords, const CandidateSet& acceptedWords) {
+    const QStringList &words = dictionaryWords();
+    const ScoringProfile &profile = defaultScoringProfile();
     // Combine all valid words
-    QSet<QString> allWords = answerWords;
-    for (const QString& w : acceptedWords) allWords.insert(w);
+    CandidateSet allWords = answerWords | acceptedWords;
     // Precompute letter frequencies by position from answer words
     QVector<QMap<QChar, int>> posFreq(5);
-    for (const QString& word : answerWords) {
+    answerWords.forEach([&](int index) {
+        const QString& word = words[index];
         for (int i = 0; i < word.size() && i < 5; ++i) {
             posFreq[i][word[i]]++;
         }
-    }
+    });
     QVector<QPair<QString, int>> scored;
-    for (const QString& word : allWords) {
+    allWords.forEach([&](int index) {
+        const QString& word = words[index];
         QSet<QChar> uniqueLetters;
         for (QChar c : word) uniqueLetters.insert(c);
-        if (uniqueLetters.size() < 5) continue; // Only 5-unique-letter words
+        if (uniqueLetters.size() < 5) return; // Only 5-unique-letter words
         int score = 0;
         for (int i = 0; i < word.size() && i < 5; ++i) {
             score += posFreq[i].value(word[i], 0);
         }
-        score += uniqueLetters.size() * 2000;
-        score -= (word.length() - uniqueLetters.size()) * 10000;
+        score += uniqueLetters.size() * profile.uniqueLetterBonus;
+        score -= (word.length() - uniqueLetters.size()) * profile.repeatPenalty;
         scored.append(qMakePair(word, score));
-    }
-    std::sort(scored.begin(), scored.end(), [](const QPair<QString, int>& a, const QPair<QString, int>& b) {
-        return a.second > b.second;
     });
-    if (scored.size() > topN) scored.resize(topN);
-    return scored;
+    return HeuristicRanking(std::vector<QPair<QString, int>>(scored.begin(), scored.end()), HeuristicOrder());
+}
+
+QVector<QPair<QString, int>> getBestStartingWords(const CandidateSet& answerWords, const CandidateSet& acceptedWords, int topN = 10) {
+    std::vector<QPair<QString, int>> best = rankStartingWords(answerWords, acceptedWords).page(0, topN);
+    return QVector<QPair<QString, int>>(best.begin(), best.end());
 }
 
 // Function to get all valid words that match constraints
-QVector<QPair<QString, int>> getAllValidWordsWithConstraints(const QSet<QString>& answerWords, const QSet<QString>& acceptedWords, const QMap<int, QChar>& greenLetters, const QMap<QChar, QSet<int>>& yellowPositions, const QSet<QChar>& yellowLetters, const QSet<QChar>& grayLetters) {
+QVector<QPair<QString, int>> getAllValidWordsWithConstraints(const CandidateSet& answerWords, const CandidateSet& acceptedWords, const QMap<int, QChar>& greenLetters, const QMap<QChar, QSet<int>>& yellowPositions, const QSet<QChar>& yellowLetters, const QSet<QChar>& grayLetters) {
+    const QStringList &words = dictionaryWords();
+    const ScoringProfile &profile = defaultScoringProfile();
     QVector<QMap<QChar, int>> posFreq(5);
-    for (const QString& word : answerWords) {
+    answerWords.forEach([&](int index) {
+        const QString& word = words[index];
         for (int i = 0; i < word.size() && i < 5; ++i) {
             posFreq[i][word[i]]++;
         }
-    }
-    QSet<QString> allWords = answerWords;
-    for (const QString& w : acceptedWords) allWords.insert(w);
+    });
+    CandidateList allWords = (answerWords | acceptedWords).toList();
     QVector<QPair<QString, int>> validWords;
     // Build required counts and forbidden positions
     QMap<QChar, int> requiredCount; // letter -> min count (only green positions count)
@@ -87,7 +271,8 @@ QVector<QPair<QString, int>> getAllValidWordsWithConstraints(const QSet<QString>
         greenPositions[it.value()].insert(it.key());
     }
     // Yellow positions are only forbidden, not counted toward required instances
-    for (const QString& word : allWords) {
+    for (int index : allWords) {
+        const QString& word = words[index];
         bool valid = true;
         QMap<QChar, int> wordCount;
         // Green check
@@ -160,137 +345,33 @@ QVector<QPair<QString, int>> getAllValidWordsWithConstraints(const QSet<QString>
                 yellowLettersUsed++;
             }
         }
-        score += yellowLettersUsed * 5000; // Significant bonus for using yellow letters
+        score += yellowLettersUsed * profile.yellowLetterBonus; // Significant bonus for using yellow letters
         
         // Reduced penalty for repeated letters when yellow letters are involved
         int repeatedLetters = word.length() - uniqueLetters.size();
         if (yellowLettersUsed > 0) {
             // If using yellow letters, reduce the penalty for repeated letters
-            score -= repeatedLetters * 1000; // Much smaller penalty
+            score -= repeatedLetters * profile.yellowRepeatPenalty; // Much smaller penalty
         } else {
             // If not using yellow letters, keep the original penalty
-            score -= repeatedLetters * 10000;
+            score -= repeatedLetters * profile.repeatPenalty;
         }
         
-        score += uniqueLetters.size() * 2000;
+        score += uniqueLetters.size() * profile.uniqueLetterBonus;
         validWords.append(qMakePair(word, score));
     }
     return validWords;
 }
 
+HeuristicRanking rankHeuristicGuesses(const CandidateSet& answerWords, const CandidateSet& acceptedWords, const QMap<int, QChar>& greenLetters, const QMap<QChar, QSet<int>>& yellowPositions, const QSet<QChar>& yellowLetters, const QSet<QChar>& grayLetters) {
+    QVector<QPair<QString, int>> validWords = getAllValidWordsWithConstraints(answerWords, acceptedWords, greenLetters, yellowPositions, yellowLetters, grayLetters);
+    return HeuristicRanking(std::vector<QPair<QString, int>>(validWords.begin(), validWords.end()), HeuristicOrder());
+}
+
 // Shared, optimized optimal guess function
-QString findOptimalGuessWithConstraints(const QSet<QString>& answerWords, const QSet<QString>& acceptedWords, const QMap<int, QChar>& greenLetters, const QMap<QChar, QSet<int>>& yellowPositions, const QSet<QChar>& yellowLetters, const QSet<QChar>& grayLetters) {
-    QVector<QMap<QChar, int>> posFreq(5);
-    for (const QString& word : answerWords) {
-        for (int i = 0; i < word.size() && i < 5; ++i) {
-            posFreq[i][word[i]]++;
-        }
-    }
-    QSet<QString> allWords = answerWords;
-    for (const QString& w : acceptedWords) allWords.insert(w);
-    QString bestWord;
-    int bestScore = -1;
-    // Build required counts and forbidden positions
-    QMap<QChar, int> requiredCount; // letter -> min count (only green positions count)
-    QMap<QChar, QSet<int>> forbiddenPositions = yellowPositions; // letter -> set of forbidden positions (yellow)
-    QMap<QChar, QSet<int>> greenPositions; // letter -> set of green positions
-    for (auto it = greenLetters.begin(); it != greenLetters.end(); ++it) {
-        requiredCount[it.value()]++;
-        greenPositions[it.value()].insert(it.key());
-    }
-    // Yellow positions are only forbidden, not counted toward required instances
-    for (const QString& word : allWords) {
-        bool valid = true;
-        QMap<QChar, int> wordCount;
-        // Green check
-        for (auto it = greenLetters.begin(); it != greenLetters.end(); ++it) {
-            if (word[it.key()] != it.value()) {
-                valid = false;
-                break;
-            }
-        }
-        if (!valid) continue;
-        // Yellow check (must not be in forbidden positions)
-        for (auto it = yellowPositions.begin(); it != yellowPositions.end(); ++it) {
-            QChar yellow = it.key();
-            for (int pos : it.value()) {
-                if (word[pos] == yellow) {
-                    valid = false;
-                    break;
-                }
-            }
-            if (!valid) break;
-        }
-        if (!valid) continue;
-        // Count letters in word and track positions
-        for (int i = 0; i < 5; ++i) {
-            wordCount[word[i]]++;
-        }
-        // Required count check (only green positions count)
-        for (auto it = requiredCount.begin(); it != requiredCount.end(); ++it) {
-            if (wordCount[it.key()] < it.value()) {
-                valid = false;
-                break;
-            }
-        }
-        if (!valid) continue;
-        // Gray logic: forbid gray letters only in positions not green/yellow for that letter
-        for (QChar gray : grayLetters) {
-            bool isGreenOrYellow = requiredCount.contains(gray) || yellowPositions.contains(gray);
-            if (!isGreenOrYellow) {
-                // If not green/yellow anywhere, must not appear at all
-                if (wordCount[gray] > 0) {
-                    valid = false;
-                    break;
-                }
-            } else {
-                // If green/yellow somewhere, must not appear in any other positions
-                for (int i = 0; i < 5; ++i) {
-                    bool isGreen = greenLetters.value(i, QChar()) == gray;
-                    bool isYellow = yellowPositions.value(gray).contains(i);
-                    if (!isGreen && !isYellow && word[i] == gray) {
-                        valid = false;
-                        break;
-                    }
-                }
-                if (!valid) break;
-            }
-        }
-        if (!valid) continue;
-        // Calculate score for this word
-        QSet<QChar> uniqueLetters;
-        int score = 0;
-        for (int i = 0; i < word.size() && i < 5; ++i) {
-            score += posFreq[i].value(word[i], 0);
-            uniqueLetters.insert(word[i]);
-        }
-        
-        // Bonus for using yellow letters (confirmed to be in solution)
-        int yellowLettersUsed = 0;
-        for (QChar yellow : yellowLetters) {
-            if (word.contains(yellow)) {
-                yellowLettersUsed++;
-            }
-        }
-        score += yellowLettersUsed * 5000; // Significant bonus for using yellow letters
-        
-        // Reduced penalty for repeated letters when yellow letters are involved
-        int repeatedLetters = word.length() - uniqueLetters.size();
-        if (yellowLettersUsed > 0) {
-            // If using yellow letters, reduce the penalty for repeated letters
-            score -= repeatedLetters * 1000; // Much smaller penalty
-        } else {
-            // If not using yellow letters, keep the original penalty
-            score -= repeatedLetters * 10000;
-        }
-        
-        score += uniqueLetters.size() * 2000;
-        if (score > bestScore) {
-            bestScore = score;
-            bestWord = word;
-        }
-    }
-    return bestWord;
+QString findOptimalGuessWithConstraints(const CandidateSet& answerWords, const CandidateSet& acceptedWords, const QMap<int, QChar>& greenLetters, const QMap<QChar, QSet<int>>& yellowPositions, const QSet<QChar>& yellowLetters, const QSet<QChar>& grayLetters) {
+    std::vector<QPair<QString, int>> best = rankHeuristicGuesses(answerWords, acceptedWords, greenLetters, yellowPositions, yellowLetters, grayLetters).page(0, 1);
+    return best.empty() ? QString() : best.front().first;
 }
 
 // ============================================================================
@@ -372,9 +453,9 @@ void MainMenuWindow::onExit() {
 // WordleGameWindow Implementation
 // ============================================================================
 
-WordleGameWindow::WordleGameWindow(QWidget *parent) : QWidget(parent), guesses(0), optimalGuessMode(false) {
+WordleGameWindow::WordleGameWindow(QWidget *parent) : QWidget(parent), guesses(0), optimalGuessMode(false), adversarialMode(false), prewarmGeneration(std::make_shared<std::atomic<int>>(0)), hintGeneration(std::make_shared<std::atomic<int>>(0)) {
     setWindowTitle("Wordle");
-    setFixedSize(500, 600);
+    setFixedSize(500, 720);
     
     layout = new QVBoxLayout(this);
     
@@ -394,8 +475,11 @@ WordleGameWindow::WordleGameWindow(QWidget *parent) : QWidget(parent), guesses(0
     // Buttons
     newGameButton = new QPushButton("New Game", this);
     backToMenuButton = new QPushButton("Back to Menu", this);
+    adversarialButton = new QPushButton("Adversarial Mode", this);
+    adversarialButton->setCheckable(true);
     optimalGuessButton = new QPushButton("Show Optimal Guess", this);
     optimalGuessButton->setCheckable(true);  // Make it a toggle button
+    analysisButton = new QPushButton("Analyze Game", this);
     optimalGuessLabel = new QLabel("", this);
     optimalGuessLabel->setStyleSheet("QLabel { font-size: 16px; font-weight: bold; color: #2196F3; }");
     
@@ -404,31 +488,19 @@ WordleGameWindow::WordleGameWindow(QWidget *parent) : QWidget(parent), guesses(0
     buttonLayout->addWidget(optimalGuessLabel);
     layout->addLayout(buttonLayout);
     
-    // Display areas
-    QLabel *previousGuessesLabel = new QLabel("Previous guesses:", this);
-    previousGuessesLabel->setAlignment(Qt::AlignCenter);
-    layout->addWidget(previousGuessesLabel);
-    guessesDisplay = new QTextEdit(this);
-    guessesDisplay->setMaximumHeight(150);
-    guessesDisplay->setReadOnly(true);
-    guessesDisplay->setFontPointSize(24);
-    guessesDisplay->setAlignment(Qt::AlignCenter);
-    layout->addWidget(guessesDisplay);
-    
     messageLabel = new QLabel(this);
     messageLabel->setAlignment(Qt::AlignCenter);
     layout->addWidget(messageLabel);
     
-    // Keyboard
-    layout->addWidget(new QLabel("Keyboard:", this));
-    QWidget *keyboardWidget = new QWidget(this);
-    keyboardLayout = new QGridLayout();
-    keyboardWidget->setLayout(keyboardLayout);
-    layout->addWidget(keyboardWidget);
+    // Guess grid and keyboard, painted in one widget
+    board = new WordleBoardWidget(sharedSolverDictionary().alphabet, GUESS_LIMIT, this);
+    layout->addWidget(board);
     
     // Bottom buttons
     QHBoxLayout *bottomButtonLayout = new QHBoxLayout();
     bottomButtonLayout->addWidget(newGameButton);
+    bottomButtonLayout->addWidget(adversarialButton);
+    bottomButtonLayout->addWidget(analysisButton);
     bottomButtonLayout->addWidget(backToMenuButton);
     layout->addLayout(bottomButtonLayout);
     
@@ -436,114 +508,36 @@ WordleGameWindow::WordleGameWindow(QWidget *parent) : QWidget(parent), guesses(0
     connect(newGameButton, &QPushButton::clicked, this, &WordleGameWindow::onNewGame);
     connect(backToMenuButton, &QPushButton::clicked, this, &WordleGameWindow::onBackToMenu);
     connect(optimalGuessButton, &QPushButton::clicked, this, &WordleGameWindow::onShowOptimalGuess);
+    connect(adversarialButton, &QPushButton::clicked, this, &WordleGameWindow::onToggleAdversarial);
+    connect(analysisButton, &QPushButton::clicked, this, &WordleGameWindow::onAnalyzeGame);
     connect(input, &QLineEdit::returnPressed, this, &WordleGameWindow::onGuess);
+    connect(input, &QLineEdit::textEdited, this, &WordleGameWindow::onInputEdited);
     
-    // Load word lists
-    QStringList wordList = loadWordList("WordList.txt");
-    QStringList acceptedList = loadWordList("AcceptedWordList");
-    
-    validWords = QSet<QString>(wordList.begin(), wordList.end());
-    validWords.unite(QSet<QString>(acceptedList.begin(), acceptedList.end()));
-    
-    setupKeyboard();
     startNewGame();
 }
 
-void WordleGameWindow::setupKeyboard() {
-    QString letters = "QWERTYUIOPASDFGHJKLZXCVBNM";
-    
-    QHBoxLayout *row1Layout = new QHBoxLayout();
-    QHBoxLayout *row2Layout = new QHBoxLayout();
-    QHBoxLayout *row3Layout = new QHBoxLayout();
-    
-    for (int i = 0; i < 26; ++i) {
-        keyboardButtons[i] = new QPushButton(QString(letters[i]), this);
-        keyboardButtons[i]->setFixedSize(30, 30);
-        keyboardButtons[i]->setStyleSheet("QPushButton { background-color: white; color: black; border: 1px solid gray; }");
-        
-        if (i < 10) {
-            row1Layout->addWidget(keyboardButtons[i]);
-        } else if (i < 19) {
-            row2Layout->addWidget(keyboardButtons[i]);
-        } else {
-            row3Layout->addWidget(keyboardButtons[i]);
-        }
-        
-        letterStates[letters[i]] = 0;
-    }
-    
-    row1Layout->insertStretch(0, 1);
-    row1Layout->addStretch(1);
-    row2Layout->insertSpacing(0, 15);
-    row2Layout->addStretch(1);
-    row3Layout->insertSpacing(0, 30);
-    row3Layout->addStretch(1);
-    
-    keyboardLayout->addLayout(row1Layout, 0, 0);
-    keyboardLayout->addLayout(row2Layout, 1, 0);
-    keyboardLayout->addLayout(row3Layout, 2, 0);
-}
-
-void WordleGameWindow::updateKeyboard(const QString &guess, const QString &feedback) {
-    QString letters = "QWERTYUIOPASDFGHJKLZXCVBNM";
-    
-    for (int i = 0; i < 5; ++i) {
-        QChar letter = guess[i];
-        int letterIndex = letters.indexOf(letter);
-        
-        if (letterIndex == -1) continue;
-        
-        int newState = 0;
-        
-        if (feedback[i] == 'G') {
-            newState = 3;
-        } else if (feedback[i] == 'Y') {
-            newState = 2;
-        } else {
-            newState = 1;
-        }
-        
-        if (newState > letterStates[letter]) {
-            letterStates[letter] = newState;
-            
-            QString color;
-            if (newState == 3) {
-                color = "green";
-            } else if (newState == 2) {
-                color = "orange";
-            } else {
-                color = "gray";
-            }
-            
-            keyboardButtons[letterIndex]->setStyleSheet(
-                QString("QPushButton { background-color: %1; color: white; border: 1px solid gray; font-weight: bold; }").arg(color)
-            );
-        }
-    }
-}
-
 void WordleGameWindow::startNewGame() {
-    QStringList answers = loadWordList("WordList.txt");
+    QStringList answers = answerWordList();
     if (answers.isEmpty()) {
-        QMessageBox::critical(this, "Error", "Could not load WordList.txt");
+        QMessageBox::critical(this, "Error", QString("Could not load %1").arg(QString::fromStdString(defaultDictionarySources().answersPath)));
         close();
         return;
     }
     answer = answers.at(QRandomGenerator::global()->bounded(answers.size()));
+    // In adversarial mode the answer is only a placeholder until the first guess
+    remainingAnswers = sharedSolverDictionary().allAnswers();
     guesses = 0;
     input->clear();
-    guessesDisplay->clear();
+    board->reset();
     guessHistory.clear();
     feedbackHistory.clear();
     optimalGuessLabel->clear();
+    ++*hintGeneration; // drops a search still running for the last game
     input->setReadOnly(false);
     input->setPlaceholderText("");
-    for (int i = 0; i < 26; ++i) {
-        keyboardButtons[i]->setStyleSheet("QPushButton { background-color: white; color: black; border: 1px solid gray; }");
-        letterStates[QChar('A' + i)] = 0;
-    }
-    messageLabel->setText("You have 5 guesses.");
+    messageLabel->setText(QString("You have %1 guesses.").arg(GUESS_LIMIT));
     input->setEnabled(true);
+    analysisButton->setEnabled(false);
     if (optimalGuessButton->isChecked()) {
         updateOptimalGuess();
     }
@@ -559,31 +553,25 @@ void WordleGameWindow::onGuess() {
         QMessageBox::warning(this, "Invalid Input", "Please enter a 5-letter word.");
         return;
     }
-    if (!validWords.contains(guess)) {
+    const SolverDictionary &dict = sharedSolverDictionary();
+    int guessIndex = dict.indexOf(guess.toStdString());
+    if (guessIndex < 0) {
         QMessageBox::warning(this, "Invalid Word", "That's not a valid word.");
         return;
     }
     guesses++;
     QString feedback = generateFeedback(guess);
+    uint8_t pattern = static_cast<uint8_t>(patternFromString(feedback.toStdString()));
+    if (!adversarialMode) {
+        remainingAnswers = filterByFeedback(dict, remainingAnswers, guessIndex, pattern);
+    }
     
     // Store guess and feedback history
     guessHistory.append(guess);
     feedbackHistory.append(feedback);
     
-    // Add guess to display with colored characters
-    QString coloredWord;
-    for (int i = 0; i < 5; ++i) {
-        if (feedback[i] == 'G') {
-            coloredWord += "<span style='color: green; font-weight: bold; font-size:24pt;'>" + QString(guess[i]) + "</span>";
-        } else if (feedback[i] == 'Y') {
-            coloredWord += "<span style='color: orange; font-weight: bold; font-size:24pt;'>" + QString(guess[i]) + "</span>";
-        } else {
-            coloredWord += "<span style='color: gray; font-weight: bold; font-size:24pt;'>" + QString(guess[i]) + "</span>";
-        }
-    }
-    guessesDisplay->append("<div style='text-align: center;'>" + coloredWord + "</div>");
-    
-    updateKeyboard(guess, feedback);
+    // Only the new row's tiles and the keys it changed are repainted
+    board->addRow(dict.packed[guessIndex], pattern);
     
     // Update optimal guess if button is checked
     if (optimalGuessButton->isChecked()) {
@@ -592,19 +580,76 @@ void WordleGameWindow::onGuess() {
     
     if (guess == answer) {
         messageLabel->setText("Congratulations! You won!");
-        input->setReadOnly(true);
-        input->setPlaceholderText("Press Enter to start a new game");
-    } else if (guesses >= 5) {
+        finishGame();
+    } else if (guesses >= GUESS_LIMIT) {
         messageLabel->setText(QString("Game over! The word was: %1").arg(answer));
-        input->setReadOnly(true);
-        input->setPlaceholderText("Press Enter to start a new game");
+        finishGame();
     } else {
-        messageLabel->setText(QString("You have %1 guesses left.").arg(5 - guesses));
+        messageLabel->setText(QString("You have %1 guesses left.").arg(GUESS_LIMIT - guesses));
     }
     
     input->clear();
 }
 
+void WordleGameWindow::onInputEdited(const QString &text) {
+    // Only worth the work while hints are on; the adversary ranks its own way
+    if (!optimalGuessButton->isChecked() || adversarialMode || input->isReadOnly()) return;
+    QString guess = text.toUpper();
+    if (guess.length() != 5) return;
+    startHintPrewarm(prewarmGeneration, remainingAnswers, guessHistory, feedbackHistory, sharedSolverDictionary().indexOf(guess.toStdString()));
+}
+
+void WordleGameWindow::playedMoves(std::vector<int> &guessIndices, std::vector<uint8_t> &patterns) const {
+    const SolverDictionary &dict = sharedSolverDictionary();
+    for (int i = 0; i < guessHistory.size(); ++i) {
+        guessIndices.push_back(dict.indexOf(guessHistory[i].toStdString()));
+        patterns.push_back(static_cast<uint8_t>(patternFromString(feedbackHistory[i].toStdString())));
+    }
+}
+
+void WordleGameWindow::finishGame() {
+    input->setReadOnly(true);
+    input->setPlaceholderText("Press Enter to start a new game");
+    analysisButton->setEnabled(true);
+    // Rank every position of the game on an idle thread so the analysis opens at once
+    std::vector<int> guessIndices;
+    std::vector<uint8_t> patterns;
+    playedMoves(guessIndices, patterns);
+    QThreadPool::globalInstance()->start([guessIndices, patterns]() {
+        analyzeGame(sharedSolverDictionary(), guessIndices, patterns, sharedSolverCache());
+    });
+}
+
+void WordleGameWindow::onAnalyzeGame() {
+    std::vector<int> guessIndices;
+    std::vector<uint8_t> patterns;
+    playedMoves(guessIndices, patterns);
+    // Each turn narrows the previous turn's bitset; best guesses come from the cache
+    std::vector<MoveAnalysis> moves = analyzeGame(sharedSolverDictionary(), guessIndices, patterns, sharedSolverCache());
+    
+    QString table = "<table cellspacing='6'><tr><th>Guess</th><th>Answers left</th><th>Bits gained</th>"
+                    "<th>Expected</th><th>Best guess</th></tr>";
+    for (const MoveAnalysis &move : moves) {
+        QString best = move.bestGuess >= 0 ? dictionaryWords()[move.bestGuess] : QString("-");
+        table += QString("<tr><td>%1</td><td>%2 &rarr; %3</td><td>%4</td><td>%5</td><td>%6 (%7)</td></tr>")
+                     .arg(dictionaryWords()[move.guess])
+                     .arg(move.candidatesBefore)
+                     .arg(move.candidatesAfter)
+                     .arg(move.bitsGained, 0, 'f', 2)
+                     .arg(move.expectedBits, 0, 'f', 2)
+                     .arg(best)
+                     .arg(move.bestExpectedBits, 0, 'f', 2);
+    }
+    table += "</table><p>Bits gained is what the feedback actually revealed; expected is what the guess "
+             "averages over the answers that were left, next to the best guess's average.</p>";
+    
+    QMessageBox box(this);
+    box.setWindowTitle("Game Analysis");
+    box.setTextFormat(Qt::RichText);
+    box.setText(table);
+    box.exec();
+}
+
 void WordleGameWindow::onNewGame() {
     startNewGame();
 }
@@ -614,6 +659,11 @@ void WordleGameWindow::onBackToMenu() {
     this->close();
 }
 
+void WordleGameWindow::onToggleAdversarial() {
+    adversarialMode = adversarialButton->isChecked();
+    startNewGame();
+}
+
 void WordleGameWindow::onShowOptimalGuess() {
     optimalGuessMode = optimalGuessButton->isChecked();
     
@@ -623,16 +673,38 @@ void WordleGameWindow::onShowOptimalGuess() {
     } else {
         optimalGuessButton->setText("Show Optimal Guess");
         optimalGuessLabel->clear();
+        ++*hintGeneration;
     }
 }
 
 void WordleGameWindow::updateOptimalGuess() {
+    if (adversarialMode) {
+        // The worst-case search takes seconds on a wide set, so it runs on the pool and
+        // posts back; bumping hintGeneration discards an answer nobody waits for
+        optimalGuessLabel->setText("Optimal: searching...");
+        int myGeneration = ++*hintGeneration;
+        QPointer<WordleGameWindow> window(this);
+        int guessesLeft = MAX_GUESSES - static_cast<int>(guessHistory.size());
+        QThreadPool::globalInstance()->start([window, generation = hintGeneration, myGeneration, candidates = remainingAnswers, guessesLeft]() {
+            AdversarialPlan plan = findAdversarialGuess(sharedSolverDictionary(), candidates, guessesLeft);
+            if (generation->load() != myGeneration) return;
+            QMetaObject::invokeMethod(qApp, [window, generation, myGeneration, plan, guessesLeft]() {
+                if (!window || generation->load() != myGeneration) return;
+                const SolverDictionary &dict = sharedSolverDictionary();
+                if (plan.worstCaseDepth > guessesLeft) {
+                    window->optimalGuessLabel->setText("Optimal: no forced win within the limit");
+                } else if (plan.guess >= 0) {
+                    window->optimalGuessLabel->setText(QString("Optimal: %1 (solves in %2)").arg(QString::fromStdString(dict.words[plan.guess])).arg(plan.worstCaseDepth));
+                } else {
+                    window->optimalGuessLabel->setText("No optimal guess found");
+                }
+            }, Qt::QueuedConnection);
+        });
+        return;
+    }
     if (guessHistory.isEmpty()) {
-        QStringList answerList = loadWordList("WordList.txt");
-        QStringList acceptedList = loadWordList("AcceptedWordList");
-        QSet<QString> answerSet(answerList.begin(), answerList.end());
-        QSet<QString> acceptedSet(acceptedList.begin(), acceptedList.end());
-        QVector<QPair<QString, int>> best = getBestStartingWords(answerSet, acceptedSet, 1);
+        const SolverDictionary &dict = sharedSolverDictionary();
+        QVector<QPair<QString, int>> best = getBestStartingWords(dict.allAnswers(), dict.allAccepted(), 1);
         if (!best.isEmpty()) {
             optimalGuessLabel->setText(QString("Optimal: %1").arg(best[0].first));
         } else {
@@ -640,36 +712,8 @@ void WordleGameWindow::updateOptimalGuess() {
         }
         return;
     }
-    // Reconstruct constraints from guessHistory and feedbackHistory
-    QMap<int, QChar> greenLetters;
-    QMap<QChar, QSet<int>> yellowPositions;
-    QSet<QChar> yellowLetters;
-    QSet<QChar> grayLetters;
-    for (int i = 0; i < guessHistory.size(); ++i) {
-        QString guess = guessHistory[i];
-        QString feedback = feedbackHistory[i];
-        for (int j = 0; j < 5; ++j) {
-            QChar letter = guess[j];
-            if (feedback[j] == 'G') {
-                greenLetters[j] = letter;
-            } else if (feedback[j] == 'Y') {
-                yellowLetters.insert(letter);
-                yellowPositions[letter].insert(j);
-            } else if (feedback[j] == 'X') {
-                bool isAlsoYellowOrGreen = false;
-                for (int k = 0; k < 5; ++k) {
-                    if (k != j && guess[k] == letter && feedback[k] != 'X') {
-                        isAlsoYellowOrGreen = true;
-                        break;
-                    }
-                }
-                if (!isAlsoYellowOrGreen) {
-                    grayLetters.insert(letter);
-                }
-            }
-        }
-    }
-    QString optimal = findOptimalGuessWithConstraints(validWords, validWords, greenLetters, yellowPositions, yellowLetters, grayLetters);
+    // Usually answered from the hints worked out while the guess was being typed
+    QString optimal = heuristicHint(guessHistory, feedbackHistory);
     if (!optimal.isEmpty()) {
         optimalGuessLabel->setText(QString("Optimal: %1").arg(optimal));
     } else {
@@ -678,8 +722,21 @@ void WordleGameWindow::updateOptimalGuess() {
 }
 
 QString WordleGameWindow::generateFeedback(const QString &guess) {
+    if (adversarialMode && !remainingAnswers.empty()) {
+        // Keep the largest feedback bucket and pick any survivor as the answer;
+        // every survivor yields the same feedback
+        const SolverDictionary &dict = sharedSolverDictionary();
+        int guessIndex = dict.indexOf(guess.toStdString());
+        if (guessIndex >= 0) {
+            remainingAnswers = adversarialResponse(dict, guessIndex, remainingAnswers).remaining;
+            answer = dictionaryWords()[remainingAnswers.first()];
+        }
+    }
+    return feedbackFor(guess, answer);
+}
+
+QString feedbackFor(const QString &guess, const QString &answer) {
     QString feedback = "XXXXX";
-    QString answerCopy = answer;
     QVector<bool> used(5, false);
     
     // Check for correct position (G)
@@ -740,8 +797,8 @@ StatsWindow::StatsWindow(QWidget *parent) : QWidget(parent) {
 }
 
 void StatsWindow::loadAndDisplayStats() {
-    QStringList answerWords = loadWordList("WordList.txt");
-    QStringList acceptedWords = loadWordList("AcceptedWordList");
+    QStringList answerWords = answerWordList();
+    QStringList acceptedWords = acceptedWordList();
     
     if (answerWords.isEmpty() || acceptedWords.isEmpty()) {
         statsDisplay->setPlainText("Error: Could not load word lists.");
@@ -843,9 +900,8 @@ void StatsWindow::loadAndDisplayStats() {
     }
     
     stats += "\n=== TOP STARTING WORDS (CONSISTENT ALGORITHM) ===\n\n";
-    QSet<QString> answerSet = QSet<QString>(answerWords.begin(), answerWords.end());
-    QSet<QString> acceptedSet = QSet<QString>(acceptedWords.begin(), acceptedWords.end());
-    QVector<QPair<QString, int>> bestWords = getBestStartingWords(answerSet, acceptedSet, 10);
+    const SolverDictionary &dict = sharedSolverDictionary();
+    QVector<QPair<QString, int>> bestWords = getBestStartingWords(dict.allAnswers(), dict.allAccepted(), 10);
     stats += "Rank  Word    Score\n";
     stats += "----------------------\n";
     for (int i = 0; i < bestWords.size(); ++i) {
@@ -864,9 +920,9 @@ void StatsWindow::onBackToMenu() {
 // SolverWindow Implementation
 // ============================================================================
 
-SolverWindow::SolverWindow(QWidget *parent) : QWidget(parent) {
+SolverWindow::SolverWindow(QWidget *parent) : QWidget(parent), prewarmGeneration(std::make_shared<std::atomic<int>>(0)) {
     setWindowTitle("Wordle Solver");
-    setFixedSize(600, 500);
+    setFixedSize(600, 640);
     
     layout = new QVBoxLayout(this);
     
@@ -915,7 +971,7 @@ SolverWindow::SolverWindow(QWidget *parent) : QWidget(parent) {
     // Gray letters (not in word) - placed below
     QHBoxLayout *grayLayout = new QHBoxLayout();
     grayInput = new QLineEdit(this);
-    grayInput->setMaxLength(26);
+    grayInput->setMaxLength(MAX_ALPHABET_SIZE);
     grayInput->setFixedWidth(220);
     grayInput->setStyleSheet("QLineEdit { font-size: 18px; padding: 10px; border: 2px solid #9E9E9E; background: black; color: white; }");
     grayInput->setPlaceholderText("");
@@ -923,8 +979,35 @@ SolverWindow::SolverWindow(QWidget *parent) : QWidget(parent) {
     grayLayout->addStretch();
     layout->addLayout(grayLayout);
 
+    // Played rows whose colors are only partly known; '?' marks an unknown tile
+    guessRowsInput = new QLineEdit(this);
+    guessRowsInput->setStyleSheet("QLineEdit { font-size: 16px; padding: 8px; border: 2px solid #9E9E9E; background: black; color: white; }");
+    guessRowsInput->setPlaceholderText("Guess rows, e.g. CRANE G?X?Y; SLOTH ?????");
+    layout->addWidget(guessRowsInput);
+    guessRowsLabel = new QLabel("", this);
+    guessRowsLabel->setStyleSheet("QLabel { font-size: 13px; color: #CCCCCC; }");
+    guessRowsLabel->setWordWrap(true);
+    layout->addWidget(guessRowsLabel);
+
+    // Free-form dictionary query, answered from the posting index as it is typed
+    queryInput = new QLineEdit(this);
+    queryInput->setStyleSheet("QLineEdit { font-size: 16px; padding: 8px; border: 2px solid #9E9E9E; background: black; color: white; }");
+    queryInput->setPlaceholderText("Query, e.g. ?R?N? +E -ST A=0-1");
+    layout->addWidget(queryInput);
+    queryLabel = new QLabel("", this);
+    queryLabel->setStyleSheet("QLabel { font-size: 13px; color: #CCCCCC; }");
+    queryLabel->setWordWrap(true);
+    layout->addWidget(queryLabel);
+
     // Buttons
     buttonLayout = new QHBoxLayout();
+    rankingModeBox = new QComboBox(this);
+    rankingModeBox->addItem("Heuristic", static_cast<int>(RankingMode::Heuristic));
+    rankingModeBox->addItem("Entropy", static_cast<int>(RankingMode::Entropy));
+    rankingModeBox->addItem("Minimax", static_cast<int>(RankingMode::Minimax));
+    rankingModeBox->addItem("Expected Size", static_cast<int>(RankingMode::ExpectedSize));
+    rankingModeBox->addItem("Two-Step Lookahead", static_cast<int>(RankingMode::Lookahead));
+    rankingModeBox->setStyleSheet("QComboBox { font-size: 14px; padding: 5px; background: black; color: white; }");
     QString mainButtonStyle = "QPushButton { font-size: 16px; padding: 15px; margin: 5px; background-color: #444; color: white; border: none; border-radius: 5px; } QPushButton:hover { background-color: #666; }";
     QString clearButtonStyle = "QPushButton { font-size: 16px; padding: 15px; margin: 5px; background-color: #444; color: white; border: none; border-radius: 5px; } QPushButton:hover { background-color: #666; }";
     QString backButtonStyle = "QPushButton { font-size: 14px; padding: 10px; background-color: #444; color: white; border: none; border-radius: 5px; } QPushButton:hover { background-color: #666; }";
@@ -932,8 +1015,12 @@ SolverWindow::SolverWindow(QWidget *parent) : QWidget(parent) {
     updateGuessesButton->setStyleSheet(mainButtonStyle);
     clearAllButton = new QPushButton("Clear All", this);
     clearAllButton->setStyleSheet(clearButtonStyle);
+    buttonLayout->addWidget(rankingModeBox);
     buttonLayout->addWidget(updateGuessesButton);
     buttonLayout->addWidget(clearAllButton);
+    moreResultsButton = new QPushButton("More Results", this);
+    moreResultsButton->setStyleSheet(clearButtonStyle);
+    buttonLayout->addWidget(moreResultsButton);
     layout->addLayout(buttonLayout);
 
     // Back button
@@ -944,8 +1031,11 @@ SolverWindow::SolverWindow(QWidget *parent) : QWidget(parent) {
     // Connect signals
     connect(updateGuessesButton, &QPushButton::clicked, this, &SolverWindow::onUpdateGuesses);
     connect(clearAllButton, &QPushButton::clicked, this, &SolverWindow::onClearAll);
+    connect(moreResultsButton, &QPushButton::clicked, this, &SolverWindow::onMoreResults);
     connect(backToMenuButton, &QPushButton::clicked, this, &SolverWindow::onBackToMenu);
     connect(grayInput, &QLineEdit::returnPressed, this, &SolverWindow::onUpdateGuesses);
+    connect(guessRowsInput, &QLineEdit::returnPressed, this, &SolverWindow::onUpdateGuesses);
+    connect(queryInput, &QLineEdit::textChanged, this, &SolverWindow::onRunQuery);
     
     setLayout(layout);
     
@@ -953,10 +1043,7 @@ SolverWindow::SolverWindow(QWidget *parent) : QWidget(parent) {
     loadWordLists();
     
     // Initialize letter states
-    QString letters = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-    for (QChar c : letters) {
-        letterStates[c] = 0;
-    }
+    letterStates.fill(0, sharedSolverDictionary().alphabet.size());
 
     // Add optimal guess label above possibleAnswersBox
     optimalGuessLabel = new QLabel("Optimal Guess: ", this);
@@ -974,43 +1061,65 @@ SolverWindow::SolverWindow(QWidget *parent) : QWidget(parent) {
 }
 
 void SolverWindow::loadWordLists() {
-    QStringList answerList = loadWordList("WordList.txt");
-    QStringList acceptedList = loadWordList("AcceptedWordList");
-    
-    answerWords = QSet<QString>(answerList.begin(), answerList.end());
-    acceptedWords = QSet<QString>(acceptedList.begin(), acceptedList.end());
+    const SolverDictionary &dict = sharedSolverDictionary();
+    answerWords = dict.allAnswers();
+    acceptedWords = dict.allAccepted();
+    sharedWordIndex();
 }
 
 void SolverWindow::onUpdateGuesses() {
+    QString rowsError;
+    if (!readGuessRows(rowsError)) {
+        optimalGuessLabel->setText("Optimal Guess: None");
+        possibleAnswersBox->setText(rowsError);
+        guessRowsLabel->clear();
+        return;
+    }
     updateLetterStates();
-    QVector<QPair<QString, int>> topGuesses = findTopGuesses(10); // get top 10 possible answers
+    shownMode = static_cast<RankingMode>(rankingModeBox->currentData().toInt());
+    shownOffset = 0;
+    if (shownMode == RankingMode::Heuristic) {
+        findTopGuesses(RESULTS_PER_PAGE); // get top 10 possible answers
+    } else {
+        rankGuessesForConstraints(shownMode);
+    }
+    QVector<QPair<QString, QString>> topGuesses = resultsPage(0);
     if (topGuesses.isEmpty()) {
         optimalGuessLabel->setText("Optimal Guess: None");
         possibleAnswersBox->setText("No valid words found with current constraints");
     } else {
-        optimalGuessLabel->setText(QString("Optimal Guess: %1").arg(topGuesses[0].first));
-        int perRow = 5; // Reduced from 8 to 5 for better readability
-        QString display;
-        for (int i = 0; i < topGuesses.size(); ++i) {
-            display += topGuesses[i].first;
-            if ((i + 1) % perRow == 0)
-                display += "\n";
-            else
-                display += "     "; // Increased spacing from 4 to 5 spaces
-        }
-        possibleAnswersBox->setText(display);
+        optimalGuessLabel->setText(QString("Optimal Guess: %1 (%2)").arg(topGuesses[0].first, topGuesses[0].second));
+        displayResults(topGuesses);
+    }
+    showGuessRowSummary();
+}
+
+void SolverWindow::onMoreResults() {
+    // Pages come from the stored ranking, nothing is rescored
+    QVector<QPair<QString, QString>> page = resultsPage(shownOffset + RESULTS_PER_PAGE);
+    if (page.isEmpty()) return;
+    shownOffset += RESULTS_PER_PAGE;
+    displayResults(page);
+}
+
+void SolverWindow::displayResults(const QVector<QPair<QString, QString>> &results) {
+    int perRow = 2; // Two per row leaves room for the metric
+    QString display;
+    for (int i = 0; i < results.size(); ++i) {
+        QString entry = QString("%1. %2  %3").arg(shownOffset + i + 1).arg(results[i].first, results[i].second);
+        if ((i + 1) % perRow == 0)
+            display += entry + "\n";
+        else
+            display += entry.leftJustified(32, ' ');
     }
+    possibleAnswersBox->setText(display);
 }
 
 void SolverWindow::onClearAll() {
     guessFeedbackPairs.clear();
-    letterStates.clear();
     
     // Reset letter states
-    QString letters = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-    for (QChar c : letters) {
-        letterStates[c] = 0;
-    }
+    letterStates.fill(0);
     
     // Clear all input boxes
     for (int i = 0; i < 5; ++i) {
@@ -1018,22 +1127,27 @@ void SolverWindow::onClearAll() {
         yellowBoxes[i]->clear();
     }
     grayInput->clear();
+    guessRowsInput->clear();
+    guessRows.clear();
+    guessRowsLabel->clear();
     
+    heuristicRanking = HeuristicRanking();
+    guessRanking = GuessRanking();
+    shownOffset = 0;
     possibleAnswersBox->clear();
 }
 
 void SolverWindow::updateLetterStates() {
     // Reset letter states
-    QString letters = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-    for (QChar c : letters) {
-        letterStates[c] = 0;
-    }
+    const SolverAlphabet &alphabet = sharedSolverDictionary().alphabet;
+    letterStates.fill(0);
     
     // Process green letters
     for (int i = 0; i < 5; ++i) {
         QString greenLetter = greenBoxes[i]->text().trimmed().toUpper();
-        if (!greenLetter.isEmpty() && greenLetter.length() == 1 && greenLetter[0].isLetter()) {
-            letterStates[greenLetter[0]] = 3; // Green
+        int index = greenLetter.length() == 1 ? alphabet.indexOf(greenLetter[0].unicode()) : -1;
+        if (index >= 0) {
+            letterStates[index] = 3; // Green
         }
     }
     
@@ -1041,8 +1155,9 @@ void SolverWindow::updateLetterStates() {
     for (int i = 0; i < 5; ++i) {
         QString yellowLetters = yellowBoxes[i]->text().trimmed().toUpper();
         for (QChar c : yellowLetters) {
-            if (c.isLetter() && letterStates[c] < 2) {
-                letterStates[c] = 2; // Yellow
+            int index = alphabet.indexOf(c.unicode());
+            if (index >= 0 && letterStates[index] < 2) {
+                letterStates[index] = 2; // Yellow
             }
         }
     }
@@ -1050,8 +1165,9 @@ void SolverWindow::updateLetterStates() {
     // Process gray letters
     QString grayLetters = grayInput->text().trimmed().toUpper();
     for (QChar c : grayLetters) {
-        if (c.isLetter() && letterStates[c] == 0) {
-            letterStates[c] = 1; // Gray
+        int index = alphabet.indexOf(c.unicode());
+        if (index >= 0 && letterStates[index] == 0) {
+            letterStates[index] = 1; // Gray
         }
     }
 }
@@ -1065,9 +1181,10 @@ QVector<QPair<QString, int>> SolverWindow::findTopGuesses(int count) {
             break;
         }
     }
-    if (allEmpty && grayInput->text().trimmed().isEmpty()) {
-        QVector<QPair<QString, int>> best = getBestStartingWords(answerWords, acceptedWords, count);
-        return best;
+    if (allEmpty && grayInput->text().trimmed().isEmpty() && guessRows.empty()) {
+        heuristicRanking = rankStartingWords(answerWords, acceptedWords);
+        std::vector<QPair<QString, int>> best = heuristicRanking.page(0, count);
+        return QVector<QPair<QString, int>>(best.begin(), best.end());
     }
     
     // Build constraints from UI
@@ -1075,7 +1192,66 @@ QVector<QPair<QString, int>> SolverWindow::findTopGuesses(int count) {
     QMap<QChar, QSet<int>> yellowPositions;
     QSet<QChar> yellowLetters;
     QSet<QChar> grayLetters;
+    readConstraints(greenLetters, yellowPositions, yellowLetters, grayLetters);
+    
+    // Rank all valid words that match constraints; only the requested head gets sorted
+    heuristicRanking = rankHeuristicGuesses(filterByGuessRows(answerWords), filterByGuessRows(acceptedWords), greenLetters, yellowPositions, yellowLetters, grayLetters);
+    std::vector<QPair<QString, int>> best = heuristicRanking.page(0, count);
+    return QVector<QPair<QString, int>>(best.begin(), best.end());
+}
+
+void SolverWindow::rankGuessesForConstraints(RankingMode mode) {
+    QMap<int, QChar> greenLetters;
+    QMap<QChar, QSet<int>> yellowPositions;
+    QSet<QChar> yellowLetters;
+    QSet<QChar> grayLetters;
+    readConstraints(greenLetters, yellowPositions, yellowLetters, grayLetters);
     
+    const SolverDictionary &dict = sharedSolverDictionary();
+    CandidateSet candidates = filterByGuessRows(possibleAnswers(dict, toSolverConstraints(greenLetters, yellowPositions, yellowLetters, grayLetters)));
+    if (candidates.empty()) {
+        guessRanking = GuessRanking(GuessOrder{mode});
+        return;
+    }
+    guessRanking = cachedRankGuesses(dict, candidates, mode, RESULTS_PER_PAGE, sharedSolverCache());
+    
+    // Warm the states the top guess most likely leads to while the user plays it
+    std::vector<GuessMetrics> best = guessRanking.page(0, 1);
+    if (!best.empty()) startPrewarm(prewarmGeneration, candidates, best.front().guess, mode);
+}
+
+QVector<QPair<QString, QString>> SolverWindow::resultsPage(int offset) {
+    QVector<QPair<QString, QString>> page; // word and the metric it was ranked by
+    if (shownMode == RankingMode::Heuristic) {
+        for (const QPair<QString, int> &guess : heuristicRanking.page(offset, RESULTS_PER_PAGE)) {
+            page.append(qMakePair(guess.first, QString("score %1").arg(guess.second)));
+        }
+        return page;
+    }
+    // One histogram pass yields every metric; show the one the list is ordered by
+    const SolverDictionary &dict = sharedSolverDictionary();
+    for (const GuessMetrics &metrics : guessRanking.page(offset, RESULTS_PER_PAGE)) {
+        QString metric;
+        if (shownMode == RankingMode::Entropy) {
+            metric = QString("%1 bits").arg(metrics.entropy, 0, 'f', 2);
+        } else if (shownMode == RankingMode::Minimax) {
+            metric = QString("max %1, avg %2").arg(metrics.worstBucket).arg(metrics.expectedSize, 0, 'f', 1);
+        } else if (shownMode == RankingMode::Lookahead) {
+            // Past the looked-ahead leaders the list continues in entropy order
+            if (std::isinf(metrics.lookaheadSize)) {
+                metric = QString("%1 bits").arg(metrics.entropy, 0, 'f', 2);
+            } else {
+                metric = QString("%1%2 after 2").arg(metrics.lookaheadBound ? ">" : "avg ").arg(metrics.lookaheadSize, 0, 'f', 2);
+            }
+        } else {
+            metric = QString("avg %1").arg(metrics.expectedSize, 0, 'f', 1);
+        }
+        page.append(qMakePair(QString::fromStdString(dict.words[metrics.guess]), metric));
+    }
+    return page;
+}
+
+void SolverWindow::readConstraints(QMap<int, QChar> &greenLetters, QMap<QChar, QSet<int>> &yellowPositions, QSet<QChar> &yellowLetters, QSet<QChar> &grayLetters) const {
     for (int i = 0; i < 5; ++i) {
         QString green = greenBoxes[i]->text().trimmed().toUpper();
         if (!green.isEmpty() && green[0].isLetter()) greenLetters[i] = green[0];
@@ -1091,20 +1267,87 @@ QVector<QPair<QString, int>> SolverWindow::findTopGuesses(int count) {
     
     QString gray = grayInput->text().trimmed().toUpper();
     for (QChar c : gray) if (c.isLetter()) grayLetters.insert(c);
-    
-    // Get all valid words that match constraints
-    QVector<QPair<QString, int>> validWords = getAllValidWordsWithConstraints(answerWords, acceptedWords, greenLetters, yellowPositions, yellowLetters, grayLetters);
-    
-    // Sort by score (highest first) and return top count
-    std::sort(validWords.begin(), validWords.end(), [](const QPair<QString, int>& a, const QPair<QString, int>& b) {
-        return a.second > b.second;
-    });
-    
-    if (validWords.size() > count) {
-        validWords.resize(count);
+}
+
+bool SolverWindow::readGuessRows(QString &error) {
+    const SolverDictionary &dict = sharedSolverDictionary();
+    std::vector<std::pair<int, PatternMask>> rows;
+    for (const QString &row : guessRowsInput->text().toUpper().split(QRegularExpression("[;,]"), Qt::SkipEmptyParts)) {
+        QStringList fields = row.split(' ', Qt::SkipEmptyParts);
+        if (fields.isEmpty()) continue;
+        PatternMask allowed;
+        int guess = fields.size() == 2 ? dict.indexOf(fields[0].toStdString()) : -1;
+        if (guess < 0 || !patternMaskFromString(fields[1].toStdString(), allowed)) {
+            error = QString("Cannot read guess row \"%1\": expected a word and five of G, Y, X or ?").arg(row.trimmed());
+            return false;
+        }
+        rows.emplace_back(guess, allowed);
     }
-    
-    return validWords;
+    guessRows = std::move(rows);
+    return true;
+}
+
+CandidateSet SolverWindow::filterByGuessRows(const CandidateSet &words) const {
+    // Summing over the unknown tiles is a union of pattern buckets; each row narrows once
+    CandidateSet consistent = words;
+    for (const auto &[guess, allowed] : guessRows) {
+        consistent = filterByPatterns(sharedSolverDictionary(), consistent, guess, allowed);
+    }
+    return consistent;
+}
+
+void SolverWindow::showGuessRowSummary() {
+    if (guessRows.empty()) {
+        guessRowsLabel->clear();
+        return;
+    }
+    QMap<int, QChar> greenLetters;
+    QMap<QChar, QSet<int>> yellowPositions;
+    QSet<QChar> yellowLetters;
+    QSet<QChar> grayLetters;
+    readConstraints(greenLetters, yellowPositions, yellowLetters, grayLetters);
+    const SolverDictionary &dict = sharedSolverDictionary();
+    CandidateList fitting = filterByGuessRows(possibleAnswers(dict, toSolverConstraints(greenLetters, yellowPositions, yellowLetters, grayLetters))).toList();
+
+    // Every fitting answer is equally likely, so a row's likeliest colors are its largest allowed bucket
+    QString summary = QString("%1 answers fit").arg(fitting.size());
+    for (const auto &[guess, allowed] : guessRows) {
+        if (allowed.count() == 1 || fitting.empty()) continue;
+        PatternHistogram histogram;
+        feedbackHistogram(dict, guess, fitting, histogram);
+        int likeliest = -1;
+        for (int pattern = 0; pattern < PATTERN_COUNT; ++pattern) {
+            if (allowed.test(pattern) && (likeliest < 0 || histogram[pattern] > histogram[likeliest])) likeliest = pattern;
+        }
+        summary += QString("; %1 likely %2 (%3%)").arg(QString::fromStdString(dict.words[guess]),
+                                                     QString::fromStdString(patternToString(static_cast<uint8_t>(likeliest))))
+                       .arg(100.0 * histogram[likeliest] / fitting.size(), 0, 'f', 0);
+    }
+    guessRowsLabel->setText(summary);
+}
+
+void SolverWindow::onRunQuery() {
+    QString text = queryInput->text().trimmed();
+    if (text.isEmpty()) {
+        queryLabel->clear();
+        return;
+    }
+    WordQuery query;
+    std::string error;
+    if (!parseWordQuery(sharedSolverDictionary().alphabet, text.toStdString(), query, error)) {
+        queryLabel->setText(QString::fromStdString(error));
+        return;
+    }
+    // Answers come first in dictionary order, so the listing leads with them
+    CandidateSet matches = sharedWordIndex().match(query, answerWords | acceptedWords);
+    int answers = (matches & answerWords).count();
+    QStringList shown;
+    matches.forEach([&](int word) {
+        if (shown.size() < QUERY_WORDS_SHOWN) shown << dictionaryWords()[word];
+    });
+    QString summary = QString("%1 answers, %2 accepted").arg(answers).arg(matches.count() - answers);
+    if (!shown.isEmpty()) summary += ": " + shown.join(", ") + (matches.count() > shown.size() ? ", ..." : "");
+    queryLabel->setText(summary);
 }
 
 void SolverWindow::onBackToMenu() {
@@ -4,6 +4,10 @@
 #include <QWidget>
 #include <QMap>
 #include <QSet>
+#include <QStringList>
+#include <atomic>
+#include <memory>
+#include "SolverCore.h"
 
 class QLineEdit;
 class QPushButton;
@@ -12,6 +16,16 @@ class QVBoxLayout;
 class QTextEdit;
 class QGridLayout;
 class QHBoxLayout;
+class QComboBox;
+class WordleBoardWidget;
+
+// Heuristic scores, best first (ties broken alphabetically)
+struct HeuristicOrder {
+    bool operator()(const QPair<QString, int> &a, const QPair<QString, int> &b) const {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    }
+};
+using HeuristicRanking = RankedResults<QPair<QString, int>, HeuristicOrder>;
 
 // Main menu window class
 class MainMenuWindow : public QWidget {
@@ -46,32 +60,39 @@ private slots:
     void onNewGame();
     void onBackToMenu();
     void onShowOptimalGuess();
+    void onToggleAdversarial();
+    void onInputEdited(const QString &text);
+    void onAnalyzeGame();
 
 private:
+    static constexpr int GUESS_LIMIT = MAX_GUESSES;
+    
     void startNewGame();
     QString generateFeedback(const QString &guess);
-    void updateKeyboard(const QString &guess, const QString &feedback);
-    void setupKeyboard();
     QString findOptimalGuess();
     void updateOptimalGuess();
+    void playedMoves(std::vector<int> &guessIndices, std::vector<uint8_t> &patterns) const;
+    void finishGame();
     
     QString answer;
     int guesses;
     bool optimalGuessMode;
+    bool adversarialMode;
     QLineEdit *input;
     QPushButton *newGameButton;
+    QPushButton *adversarialButton;
     QPushButton *backToMenuButton;
     QPushButton *optimalGuessButton;
+    QPushButton *analysisButton; // enabled once the game is over
     QLabel *optimalGuessLabel;
     QLabel *messageLabel;
-    QTextEdit *guessesDisplay;
+    WordleBoardWidget *board; // guess grid and keyboard
     QVBoxLayout *layout;
-    QGridLayout *keyboardLayout;
-    QPushButton *keyboardButtons[26];
-    QMap<QChar, int> letterStates; // 0=unused, 1=gray, 2=yellow, 3=green
-    QSet<QString> validWords;
     QVector<QString> guessHistory;
     QVector<QString> feedbackHistory;
+    CandidateSet remainingAnswers; // answers consistent with every feedback so far
+    std::shared_ptr<std::atomic<int>> prewarmGeneration; // bumped to cancel stale background warming
+    std::shared_ptr<std::atomic<int>> hintGeneration;    // bumped to drop a stale background hint
 };
 
 // Stats window class
@@ -106,33 +127,67 @@ private slots:
     void onBackToMenu();
     void onUpdateGuesses();
     void onClearAll();
+    void onMoreResults();
+    void onRunQuery();
 
 private:
+    static constexpr int RESULTS_PER_PAGE = 10;
+    static constexpr int QUERY_WORDS_SHOWN = 40;
+    
     void updateGuessesDisplay();
     void updateLetterStates();
     QVector<QPair<QString, int>> findTopGuesses(int count);
+    void rankGuessesForConstraints(RankingMode mode);
+    QVector<QPair<QString, QString>> resultsPage(int offset);
+    void displayResults(const QVector<QPair<QString, QString>> &results);
+    void readConstraints(QMap<int, QChar> &greenLetters, QMap<QChar, QSet<int>> &yellowPositions, QSet<QChar> &yellowLetters, QSet<QChar> &grayLetters) const;
+    bool readGuessRows(QString &error);
+    CandidateSet filterByGuessRows(const CandidateSet &words) const;
+    void showGuessRowSummary();
     void loadWordLists();
     
     QPushButton *backToMenuButton;
     QPushButton *updateGuessesButton;
     QPushButton *clearAllButton;
+    QPushButton *moreResultsButton;
     QLineEdit *greenBoxes[5];
     QLineEdit *yellowBoxes[5];
     QLineEdit *grayInput;
+    QLineEdit *guessRowsInput;
+    QLabel *guessRowsLabel;
+    QLineEdit *queryInput;
+    QLabel *queryLabel;
+    QComboBox *rankingModeBox;
     QLabel *optimalGuessLabel;
     QLabel *possibleAnswersBox;
     QTextEdit *guessesDisplay;
     QVBoxLayout *layout;
     QHBoxLayout *feedbackLayout;
     QHBoxLayout *buttonLayout;
-    QSet<QString> answerWords;
-    QSet<QString> acceptedWords;
+    CandidateSet answerWords;
+    CandidateSet acceptedWords;
     QVector<QPair<QString, QString>> guessFeedbackPairs; // guess and feedback pairs
-    QMap<QChar, int> letterStates; // 0=unused, 1=gray, 2=yellow, 3=green
+    QVector<int> letterStates; // by alphabet letter: 0=unused, 1=gray, 2=yellow, 3=green
+    std::vector<std::pair<int, PatternMask>> guessRows; // played guess and every feedback its row may have had
+    RankingMode shownMode = RankingMode::Heuristic;
+    int shownOffset = 0; // rank of the first result on screen
+    HeuristicRanking heuristicRanking;
+    GuessRanking guessRanking;
+    std::shared_ptr<std::atomic<int>> prewarmGeneration;
 };
 
-QString findOptimalGuessShared(const QSet<QString> &answerWords, const QSet<QString> &acceptedWords, const QList<QPair<QString, QString>> &guessFeedbackPairs, const QMap<int, QChar> &greenLetters, const QMap<QChar, QSet<int>> &yellowPositions, const QSet<QChar> &yellowLetters, const QSet<QChar> &grayLetters);
-QString findOptimalGuessWithConstraints(const QSet<QString>& answerWords, const QSet<QString>& acceptedWords, const QMap<int, QChar>& greenLetters, const QMap<QChar, QSet<int>>& yellowPositions, const QSet<QChar>& yellowLetters, const QSet<QChar>& grayLetters);
-QVector<QPair<QString, int>> getAllValidWordsWithConstraints(const QSet<QString>& answerWords, const QSet<QString>& acceptedWords, const QMap<int, QChar>& greenLetters, const QMap<QChar, QSet<int>>& yellowPositions, const QSet<QChar>& yellowLetters, const QSet<QChar>& grayLetters);
+// Solver dictionary loaded once from the configured sources and shared by every window
+const SolverDictionary& sharedSolverDictionary();
+// Dictionary words as QStrings, converted once and indexed like the dictionary
+const QStringList& dictionaryWords();
+
+// "GYX" feedback string for guess against answer, as the game window shows it
+QString feedbackFor(const QString &guess, const QString &answer);
+
+QString findOptimalGuessShared(const CandidateSet &answerWords, const CandidateSet &acceptedWords, const QList<QPair<QString, QString>> &guessFeedbackPairs, const QMap<int, QChar> &greenLetters, const QMap<QChar, QSet<int>> &yellowPositions, const QSet<QChar> &yellowLetters, const QSet<QChar> &grayLetters);
+QString findOptimalGuessWithConstraints(const CandidateSet& answerWords, const CandidateSet& acceptedWords, const QMap<int, QChar>& greenLetters, const QMap<QChar, QSet<int>>& yellowPositions, const QSet<QChar>& yellowLetters, const QSet<QChar>& grayLetters);
+HeuristicRanking rankStartingWords(const CandidateSet& answerWords, const CandidateSet& acceptedWords);
+HeuristicRanking rankHeuristicGuesses(const CandidateSet& answerWords, const CandidateSet& acceptedWords, const QMap<int, QChar>& greenLetters, const QMap<QChar, QSet<int>>& yellowPositions, const QSet<QChar>& yellowLetters, const QSet<QChar>& grayLetters);
+QVector<QPair<QString, int>> getAllValidWordsWithConstraints(const CandidateSet& answerWords, const CandidateSet& acceptedWords, const QMap<int, QChar>& greenLetters, const QMap<QChar, QSet<int>>& yellowPositions, const QSet<QChar>& yellowLetters, const QSet<QChar>& grayLetters);
 
 #endif // WORDLEWINDOW_H 
\ No newline at end of file
@@ -1,18 +1,34 @@
 #ifdef USE_QT
 #include <QApplication>
+#include <QDebug>
 #include "WordleWindow.h"
+#include "DictionaryLoader.h"
+#include "HeuristicScoring.h"
+#include "SolverVerify.h"
+#include <cstring>
 
 int main(int argc, char *argv[]) {
+    setDefaultDictionarySources(dictionarySourcesFromArgs(argc, argv));
+    ScoringProfile profile;
+    std::string error;
+    if (!scoringProfileFromArgs(argc, argv, profile, error)) {
+        qWarning() << QString::fromStdString(error) << "- using the built-in scoring";
+    }
+    setDefaultScoringProfile(profile);
+    // Differential check of the legacy code paths; no window needed
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--verify") == 0) return runSolverVerification(argc, argv);
+    }
     QApplication app(argc, argv);
     MainMenuWindow window;
     window.show();
     return app.exec();
 }
 #else
-#include <iostream>
+#include "SolverCli.h"
 
+// Without a command the solver serves its line protocol on stdin/stdout
 int main(int argc, char *argv[]) {
-    std::cout << "GUI not available. Rebuild with Qt support." << std::endl;
-    return 1;
+    return runSolverCli(argc, argv);
 }
 #endif
\ No newline at end of file